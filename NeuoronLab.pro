@@ -7,20 +7,23 @@ CONFIG -= warn_on
 # Include path
 INCLUDEPATH += include .
 
+# Qt-independent core (see core.pri)
+include(core.pri)
+
 # Source files
 SOURCES += \
     src/main.cpp \
     src/mainwindow.cpp \
-    src/neuralnetwork.cpp \
     src/renderarea.cpp \
-    src/errorgraph.cpp
+    src/errorgraph.cpp \
+    src/sweepdialog.cpp
 
 # Header files
 HEADERS += \
     include/errorgraph.h \
     include/mainwindow.h \
-    include/neuralnetwork.h \
-    include/renderarea.h
+    include/renderarea.h \
+    include/sweepdialog.h
 
 # Form files
 FORMS += \
@@ -0,0 +1,16 @@
+TEMPLATE = app
+TARGET = NeuoronLabCli
+
+QT -= core gui
+CONFIG += c++17 console
+CONFIG -= qt app_bundle warn_on
+
+# Include path
+INCLUDEPATH += include
+
+# Qt-independent core (see core.pri)
+include(core.pri)
+
+# Source files
+SOURCES += \
+    src/cli.cpp
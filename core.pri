@@ -0,0 +1,41 @@
+# Qt-independent core shared by the GUI and the headless CLI
+INCLUDEPATH += $$PWD/include
+
+SOURCES += \
+    $$PWD/src/neuralnetwork.cpp \
+    $$PWD/src/dataset.cpp \
+    $$PWD/src/sweepengine.cpp \
+    $$PWD/src/checkpoint.cpp \
+    $$PWD/src/atomicfile.cpp \
+    $$PWD/src/metrics.cpp \
+    $$PWD/src/allocmetrics.cpp \
+    $$PWD/src/threadpool.cpp \
+    $$PWD/src/evaluator.cpp \
+    $$PWD/src/autotuner.cpp \
+    $$PWD/src/importancesampler.cpp \
+    $$PWD/src/lbfgs.cpp \
+    $$PWD/src/onlinetrainer.cpp \
+    $$PWD/src/pointindex.cpp
+
+HEADERS += \
+    $$PWD/include/neuralnetwork.h \
+    $$PWD/include/dataset.h \
+    $$PWD/include/sweepengine.h \
+    $$PWD/include/checkpoint.h \
+    $$PWD/include/atomicfile.h \
+    $$PWD/include/metrics.h \
+    $$PWD/include/random.h \
+    $$PWD/include/threadpool.h \
+    $$PWD/include/evaluator.h \
+    $$PWD/include/autotuner.h \
+    $$PWD/include/importancesampler.h \
+    $$PWD/include/lbfgs.h \
+    $$PWD/include/ingestqueue.h \
+    $$PWD/include/onlinetrainer.h \
+    $$PWD/include/pointindex.h
+
+unix: LIBS += -lpthread
+win32: LIBS += -lws2_32
+
+# Count every heap allocation in the metrics (small per-allocation cost)
+alloc_metrics: DEFINES += NEURONLAB_ALLOC_METRICS
@@ -0,0 +1,10 @@
+#ifndef ATOMICFILE_H
+#define ATOMICFILE_H
+
+#include <string>
+
+// Writes "<path>.tmp", flushes it to disk and renames it over 'path'.
+// Readers see either the old or the new file, never a partial one.
+bool writeFileAtomically(const std::string &path, const std::string &bytes);
+
+#endif // ATOMICFILE_H
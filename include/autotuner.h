@@ -0,0 +1,51 @@
+#ifndef AUTOTUNER_H
+#define AUTOTUNER_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "neuralnetwork.h"
+#include "threadpool.h"
+
+// --- Tuning Cache ---
+// Winning kernel configs, one line per "<cpu model>|<threads>t|<layer shape>" key.
+// Loaded once at startup; rewritten atomically whenever a new entry is tuned.
+class TuningCache {
+public:
+    static TuningCache &instance();
+
+    bool load(const std::string &path); // A missing file is an empty cache
+    bool save() const;
+
+    bool lookup(const std::string &key, KernelConfig &out) const;
+    void store(const std::string &key, const KernelConfig &config);
+    std::string getPath() const;
+
+private:
+    TuningCache() = default;
+
+    mutable std::mutex mutex;
+    std::string path;
+    std::map<std::string, KernelConfig> entries;
+};
+
+// Benchmarks inference kernel configs for a network topology on this machine
+class Autotuner {
+public:
+    // Runs the real evaluation path on synthetic inputs; returns the fastest config.
+    // 'priority' is the pool priority of the benchmark runs (LOW for background tuning).
+    static KernelConfig tune(const NeuralNetwork &network, TaskPriority priority = TaskPriority::HIGH,
+                             double *nsPerSample = nullptr);
+
+    // Applies the cached config for this topology. On a miss it tunes first when
+    // 'tuneIfMissing' is set (and stores the result), otherwise keeps the defaults.
+    // Returns true if a tuned config is in effect.
+    static bool apply(NeuralNetwork &network, bool tuneIfMissing, TaskPriority priority = TaskPriority::HIGH);
+
+    static std::string cacheKey(const NeuralNetwork &network);
+    static std::string cpuModel();
+    static std::string defaultCachePath(); // Per-user config directory, shared by GUI and CLI
+    static std::string describe(const KernelConfig &config);
+};
+
+#endif // AUTOTUNER_H
@@ -0,0 +1,74 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "neuralnetwork.h"
+#include "dataset.h"
+#include "lbfgs.h"
+
+// Everything needed to continue a training run exactly where it stopped.
+// Plain SGD keeps no optimizer state besides the learning rate (importance
+// sampling adds its loss estimates, L-BFGS its curvature pairs); the RNG is
+// counter-based, so the seed and epoch fully determine its state.
+struct TrainingState {
+    NeuralNetwork network;
+    int epoch = 0;              // Completed epochs of the current run
+    int maxEpochs = 0;
+    double learningRate = 0.0;
+    std::vector<double> pruneSparsity; // Target per layer (empty = no pruning)
+    uint64_t seed = NeuralNetwork::DEFAULT_SEED; // Shuffle order is a function of (seed, epoch)
+    double axisRange = 10.0;    // Points are divided by this before training (0 = not recorded, version 5 and older)
+    std::vector<DataPoint> points;
+    std::vector<double> errorHistory;
+
+    // Importance sampling (draws depend on the per-sample loss estimates)
+    bool importanceSampling = false;
+    double importanceFraction = 0.25;
+    int fullSweepInterval = 10;
+    std::vector<double> sampleLosses;
+
+    // Optimizer (L-BFGS: one epoch is one quasi-Newton iteration)
+    OptimizerType optimizer = OptimizerType::SGD;
+    std::vector<std::vector<double>> lbfgsS; // Parameter changes, oldest first
+    std::vector<std::vector<double>> lbfgsY; // Matching gradient changes
+};
+
+namespace Checkpoint {
+    // Writes to "<path>.tmp" and renames over 'path', so a crash never leaves a torn file
+    bool save(const std::string &path, const TrainingState &state);
+    bool load(const std::string &path, TrainingState &state);
+}
+
+// Background checkpoint writer.
+// submit() only swaps a pointer under the lock; serialization and disk I/O happen
+// on the writer thread. If the writer falls behind, older snapshots are dropped.
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(const std::string &path);
+    ~CheckpointWriter(); // Writes the last pending snapshot, then joins
+
+    void submit(std::unique_ptr<TrainingState> state);
+
+    const std::string &getPath() const { return path; }
+    int getWrittenCount() const;
+    bool hasFailed() const;
+
+private:
+    void run();
+
+    std::string path;
+    std::thread worker;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::unique_ptr<TrainingState> pending;
+    bool stopping;
+    bool failed;
+    int written;
+};
+
+#endif // CHECKPOINT_H
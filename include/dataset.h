@@ -0,0 +1,52 @@
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "neuralnetwork.h"
+
+struct DataPoint {
+    double x; // World Coordinate X
+    double y; // World Coordinate Y
+    int classID;
+};
+
+// Flattened, network-ready training set.
+// Inputs are normalized once here instead of on every epoch.
+struct Dataset {
+    TaskMode mode = TaskMode::CLASSIFICATION;
+    int inputSize = 0;
+    int outputSize = 0;
+
+    std::vector<std::vector<double>> inputs;
+    std::vector<int> labels;     // Class index (Classification)
+    std::vector<double> values;  // Target Y (Regression)
+
+    size_t size() const { return inputs.size(); }
+    bool empty() const { return inputs.empty(); }
+
+    // Fills 'target' for sample i (One-Hot for classification, Y for regression)
+    void buildTarget(size_t i, double targetMin, std::vector<double> &target) const;
+
+    // Shuffled visiting order for one epoch; depends only on (seed, epoch)
+    void epochOrder(uint64_t seed, int epoch, std::vector<size_t> &order) const;
+
+    // Appends one clicked point, normalized by the axis range (same layout as fromPoints)
+    void append(const DataPoint &p, double range);
+
+    // Builds a dataset from clicked points, normalized by the axis range
+    static Dataset fromPoints(const std::vector<DataPoint> &points, double range, TaskMode mode, int outputSize);
+
+    // Loads "x,y,class" (or "x,y" for regression) lines. Returns false on I/O error.
+    static bool loadPoints(const std::string &path, std::vector<DataPoint> &points);
+
+    // Loads an MNIST-style IDX pair (ubyte images + labels), pixels scaled to 0..1.
+    // Returns false on I/O error or mismatched files.
+    static bool loadIdx(const std::string &imagesPath, const std::string &labelsPath, Dataset &out);
+
+    // Target range of the output activation (Tanh: -1..1, Sigmoid: 0..1)
+    static double targetMinFor(ActivationType act) { return act == ActivationType::TANH ? -1.0 : 0.0; }
+};
+
+#endif // DATASET_H
@@ -15,6 +15,8 @@ public:
     // Clears the graph history
     void clear();
 
+    const std::vector<double>& getErrors() const { return errors; }
+
 protected:
     void paintEvent(QPaintEvent *event) override;
 
@@ -0,0 +1,44 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <vector>
+#include <string>
+#include "neuralnetwork.h"
+#include "dataset.h"
+#include "threadpool.h"
+
+struct EvaluationResult {
+    TaskMode mode = TaskMode::CLASSIFICATION;
+    size_t samples = 0;
+    int classes = 0;
+
+    size_t correct = 0;
+    double accuracy = 0.0;  // Classification only (0..1)
+    double meanLoss = 0.0;  // 0.5 * squared error per sample, same measure as training
+
+    // Classification only
+    std::vector<size_t> confusion;   // classes x classes, row = true class, column = predicted
+    std::vector<double> classLoss;   // Mean loss of the samples of each true class
+    std::vector<size_t> classCount;  // Samples per true class
+
+    double wallTimeMs = 0.0;
+
+    size_t confusionAt(int actual, int predicted) const { return confusion[actual * classes + predicted]; }
+
+    // Plain-text report (accuracy, per-class loss, confusion matrix)
+    std::string format() const;
+};
+
+// Scores a whole data set with batched, multi-threaded inference.
+// Only const inference is used: the network's training state is never touched.
+// Batch size, sample blocking and thread count follow network.getKernelConfig().
+class Evaluator {
+public:
+    // Call network.prepareInference() first so pruned layers can use their CSR kernels.
+    // Background work (e.g. GUI autotuning) passes TaskPriority::LOW so it yields
+    // pool workers to training.
+    static EvaluationResult evaluate(const NeuralNetwork &network, const Dataset &data,
+                                     TaskPriority priority = TaskPriority::HIGH);
+};
+
+#endif // EVALUATOR_H
@@ -0,0 +1,52 @@
+#ifndef IMPORTANCESAMPLER_H
+#define IMPORTANCESAMPLER_H
+
+#include <vector>
+#include <cstdint>
+#include "neuralnetwork.h"
+#include "dataset.h"
+
+struct ImportanceConfig {
+    double sampleFraction = 0.25; // Share of the data set drawn in an importance epoch
+    int fullSweepInterval = 10;   // Every N-th epoch visits every sample once, unweighted
+    double uniformMix = 0.3;      // Probability mass spread evenly: keeps every sample reachable
+                                  // and caps the correction weight at 1 / uniformMix
+};
+
+// Hard-example importance sampling for single-sample SGD.
+// Each sample keeps the loss train() reported the last time it was visited.
+// Importance epochs draw samples with probability p_i ~ loss_i (mixed with
+// uniform) and scale each step by 1 / (N * p_i), so the expected update
+// equals that of a plain sweep over the same number of samples.
+// Periodic full sweeps refresh every estimate and keep the run unbiased.
+class ImportanceSampler {
+public:
+    explicit ImportanceSampler(const ImportanceConfig &config = ImportanceConfig());
+
+    // Trains one epoch and returns its error on the same scale as a plain
+    // sweep: the sum of all per-sample loss estimates.
+    // Draws are a function of (seed, epoch, loss estimates) only.
+    double trainEpoch(NeuralNetwork &network, const Dataset &data, double learningRate, uint64_t seed, int epoch);
+
+    size_t getLastSampleCount() const { return lastSampleCount; }
+    bool wasFullSweep() const { return lastWasFullSweep; }
+
+    const ImportanceConfig &getConfig() const { return config; }
+    void setConfig(const ImportanceConfig &c) { config = c; }
+
+    // Loss estimates (persisted in checkpoints so a resumed run draws the same samples)
+    const std::vector<double> &getLosses() const { return losses; }
+    void setLosses(const std::vector<double> &l) { losses = l; }
+    void reset() { losses.clear(); } // Forget all estimates: the next epoch is a full sweep
+
+private:
+    ImportanceConfig config;
+    std::vector<double> losses; // -1 = not visited yet
+    std::vector<double> cumulative;
+    std::vector<size_t> order;
+    std::vector<double> target;
+    size_t lastSampleCount;
+    bool lastWasFullSweep;
+};
+
+#endif // IMPORTANCESAMPLER_H
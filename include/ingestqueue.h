@@ -0,0 +1,54 @@
+#ifndef INGESTQUEUE_H
+#define INGESTQUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Unbounded lock-free multi-producer / single-consumer queue (Vyukov's intrusive MPSC).
+// push() is wait-free (one atomic exchange) and may be called from any thread;
+// pop() must only ever be called by one consumer at a time.
+template <typename T>
+class IngestQueue {
+public:
+    IngestQueue() : head(new Node), tail(head.load(std::memory_order_relaxed)) {}
+
+    ~IngestQueue() {
+        T discarded;
+        while (pop(discarded)) {}
+        delete tail;
+    }
+
+    IngestQueue(const IngestQueue &) = delete;
+    IngestQueue &operator=(const IngestQueue &) = delete;
+
+    void push(T value) {
+        Node *node = new Node;
+        node->value = std::move(value);
+        Node *prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Returns false when empty. A push that is still linking its node reads as empty
+    // for that instant; the value shows up on the next call.
+    bool pop(T &out) {
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        out = std::move(next->value);
+        delete tail;
+        tail = next; // 'next' becomes the new stub
+        return true;
+    }
+
+    bool empty() const { return tail->next.load(std::memory_order_acquire) == nullptr; }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{ nullptr };
+        T value{};
+    };
+
+    std::atomic<Node*> head; // Producers append here
+    Node *tail;              // Consumer-owned stub
+};
+
+#endif // INGESTQUEUE_H
@@ -0,0 +1,71 @@
+#ifndef LBFGS_H
+#define LBFGS_H
+
+#include <deque>
+#include <vector>
+#include "neuralnetwork.h"
+#include "dataset.h"
+
+enum class OptimizerType { SGD, LBFGS };
+
+struct LbfgsConfig {
+    int historySize = 10;            // (s, y) pairs kept for the inverse-Hessian estimate
+    int maxLineSearchSteps = 20;     // Loss/gradient passes allowed per iteration
+    double gradientTolerance = 1e-7; // Converged once the largest gradient entry drops below this
+    double sufficientDecrease = 1e-4; // Wolfe c1
+    double curvature = 0.9;           // Wolfe c2
+};
+
+// Full-batch L-BFGS with a strong Wolfe line search.
+// Meant for the small point sets drawn in the GUI: every iteration sees the
+// exact loss and gradient of the whole data set, so a tiny network usually
+// converges in tens of iterations instead of thousands of SGD epochs.
+// The learning rate is not used; the line search picks each step length.
+class LbfgsOptimizer {
+public:
+    explicit LbfgsOptimizer(const LbfgsConfig &config = LbfgsConfig());
+
+    // One quasi-Newton iteration (the L-BFGS counterpart of an epoch).
+    // Returns the loss at the new parameters on the train() scale: the sum of
+    // 0.5 * error^2 over all samples. Does nothing once converged.
+    double step(NeuralNetwork &network, const Dataset &data);
+
+    bool hasConverged() const { return converged; }
+    int getLastEvaluations() const { return lastEvaluations; } // Full passes in the last step()
+
+    // Drops the history: the next step is steepest descent again
+    void reset();
+
+    // Curvature pairs (persisted in checkpoints so a resumed run takes the same steps)
+    void getHistory(std::vector<std::vector<double>> &s, std::vector<std::vector<double>> &y) const;
+    void setHistory(const std::vector<std::vector<double>> &s, const std::vector<std::vector<double>> &y);
+
+    // Loss and gradient over the whole data set. Fixed-size chunks run on the
+    // ThreadPool and are summed in chunk order, so the result does not depend
+    // on the thread count.
+    static double lossAndGradient(const NeuralNetwork &network, const Dataset &data, std::vector<double> &gradient);
+
+private:
+    struct LinePoint {
+        double step = 0.0;
+        double loss = 0.0;
+        double slope = 0.0; // Directional derivative along the search direction
+    };
+
+    double evaluateAt(NeuralNetwork &network, const Dataset &data, double stepLength, LinePoint &point);
+    void searchDirection();
+
+    LbfgsConfig config;
+    std::deque<std::vector<double>> sHistory; // Parameter changes
+    std::deque<std::vector<double>> yHistory; // Gradient changes
+    std::vector<double> params;
+    std::vector<double> gradient;
+    std::vector<double> direction;
+    std::vector<double> trialParams;
+    std::vector<double> trialGradient;
+    double loss;
+    bool converged;
+    int lastEvaluations;
+};
+
+#endif // LBFGS_H
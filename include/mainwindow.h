@@ -2,7 +2,15 @@
 #define MAINWINDOW_H
 
 #include <QMainWindow>
+#include <QThread>
+#include <QTimer>
 #include "neuralnetwork.h"
+#include "dataset.h"
+#include "checkpoint.h"
+#include "evaluator.h"
+#include "importancesampler.h"
+#include "lbfgs.h"
+#include "onlinetrainer.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -22,19 +30,56 @@ private slots:
     void on_btnTest_clicked();
     void on_btnReset_clicked();
 
+    // --- Menu Actions ---
+    void on_actionSweep_triggered();
+    void on_actionResume_triggered();
+    void on_actionLoadPoints_triggered();
+    void on_actionEvaluate_triggered();
+    void on_actionOnline_toggled(bool checked);
+
     // --- Configuration Changes ---
     void on_cmbMode_currentIndexChanged(int index);
     void on_spinCurrentClass_valueChanged(int arg1);
+    void on_cmbOptimizer_currentIndexChanged(int index);
+
+    // --- Online Training ---
+    void onlineTick();
+
+    // --- Kernel Autotuning ---
+    void onTuningFinished();
 
 private:
     Ui::MainWindow *ui;
     NeuralNetwork *network;
+    CheckpointWriter *checkpointWriter; // Created on first snapshot
+    ImportanceSampler sampler;          // Per-point loss estimates (Tools > Importance Sampling)
+    LbfgsOptimizer lbfgs;               // Curvature history while the L-BFGS optimizer is selected
+    std::vector<double> pruneSparsity;  // Per-layer targets of the current run (parsed from editSparsity)
+    uint64_t runSeed;                   // Seed of the current network; may exceed what spinSeed can hold
+
+    // Online mode: clicked points reach the trainer through a lock-free queue
+    OnlineTrainer online;
+    Dataset onlineData;                 // Grows point by point, rebuilt only when invalidated
+    bool onlineDataValid;
+    QTimer *onlineTimer;
+
+    QThread *tuningThread;              // Background kernel benchmark (null when idle)
 
     // State Flags
     bool isTraining;
     bool hasTrained;
+    int runEpoch; // Completed epochs of the current (possibly paused) run
+
+    static const int CHECKPOINT_INTERVAL_MS = 5000;
+    static const int ONLINE_TICK_MS = 15;
 
     // Internal Helpers
     void updateUIForMode();
+    Dataset buildDataset();
+    QString checkpointPath();
+    void submitCheckpoint(int completedEpochs);
+    EvaluationResult evaluate(const Dataset &data, const QString &label); // Updates lblAccuracy
+    void applyKernelTuning(); // Cached inference kernels for 'network'; a miss is tuned in the background
+    void resetOnline();       // Points or network changed wholesale: rebuild the online data set
 };
 #endif // MAINWINDOW_H
@@ -0,0 +1,135 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// --- Metric Types ---
+// Updates are single relaxed atomics: safe from any thread, no locks on the hot path.
+
+class MetricCounter {
+public:
+    void inc(uint64_t n = 1) { value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t get() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value{0};
+};
+
+class MetricGauge {
+public:
+    void set(double v) { bits.store(toBits(v), std::memory_order_relaxed); }
+    double get() const { return fromBits(bits.load(std::memory_order_relaxed)); }
+
+private:
+    static uint64_t toBits(double v) { uint64_t b; memcpy(&b, &v, sizeof(b)); return b; }
+    static double fromBits(uint64_t b) { double v; memcpy(&v, &b, sizeof(v)); return v; }
+    std::atomic<uint64_t> bits{0};
+};
+
+class MetricHistogram {
+public:
+    explicit MetricHistogram(const std::vector<double> &upperBounds);
+
+    void observe(double v);
+
+    const std::vector<double> &getBounds() const { return bounds; }
+    uint64_t getBucket(size_t i) const { return buckets[i].load(std::memory_order_relaxed); } // Non-cumulative
+    uint64_t getCount() const { return count.load(std::memory_order_relaxed); }
+    double getSum() const;
+
+private:
+    std::vector<double> bounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> buckets; // bounds.size() + 1 (+Inf)
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sumBits{0};
+};
+
+#ifdef NEURONLAB_ALLOC_METRICS
+// Incremented by the replacement operator new (allocmetrics.cpp)
+MetricCounter &allocationCounter();
+#endif
+
+// --- Registry ---
+// Registration takes a lock (startup only); rendering reads the atomics.
+class MetricsRegistry {
+public:
+    static MetricsRegistry &instance();
+
+    MetricCounter &counter(const std::string &name, const std::string &help);
+    MetricGauge &gauge(const std::string &name, const std::string &help);
+    MetricHistogram &histogram(const std::string &name, const std::string &help, const std::vector<double> &bounds);
+    void registerCounter(const std::string &name, const std::string &help, MetricCounter *external);
+
+    // OpenMetrics text exposition, terminated by "# EOF"
+    std::string render() const;
+
+private:
+    enum class Kind { COUNTER, GAUGE, HISTOGRAM };
+    struct Entry {
+        std::string name;
+        std::string help;
+        Kind kind;
+        void *metric;
+    };
+
+    MetricsRegistry() = default;
+
+    mutable std::mutex mutex;
+    std::vector<Entry> entries;
+    std::vector<std::unique_ptr<MetricCounter>> counters;
+    std::vector<std::unique_ptr<MetricGauge>> gauges;
+    std::vector<std::unique_ptr<MetricHistogram>> histograms;
+};
+
+// Metrics fed by the training loops and the inference path
+struct CoreMetrics {
+    MetricCounter &trainSamples;
+    MetricCounter &trainEpochs;
+    MetricHistogram &epochDuration;
+    MetricGauge &trainLoss;
+    MetricGauge &samplesPerSecond;
+    MetricCounter &predictCalls;
+    MetricHistogram &predictLatency;
+
+    static CoreMetrics &get();
+
+    // Called once per epoch by a training loop
+    void recordEpoch(size_t samples, double seconds, double loss);
+
+    // predict() counts every call exactly but times only one in PREDICT_SAMPLE_RATE,
+    // to keep clock reads off the hot path
+    static const unsigned PREDICT_SAMPLE_RATE = 16;
+};
+
+// --- Exporter ---
+// Serves the registry as OpenMetrics on 127.0.0.1:<port>/metrics,
+// or rewrites a textfile (atomically) every few seconds.
+// Clients are served one at a time; each gets at most CLIENT_TIMEOUT_MS, so a
+// stalled connection can neither block other scrapers for long nor shutdown.
+class MetricsExporter {
+public:
+    MetricsExporter();
+    ~MetricsExporter();
+
+    bool serveHttp(int port);
+    void writeTextfile(const std::string &path, int intervalMs = 5000);
+
+    static const int CLIENT_TIMEOUT_MS = 2000;
+
+private:
+    void httpLoop(intptr_t listenSocket);
+    void serveClient(intptr_t clientSocket);
+    void textfileLoop(std::string path, int intervalMs);
+
+    std::atomic<bool> stopping;
+    std::vector<std::thread> threads;
+};
+
+#endif // METRICS_H
@@ -2,13 +2,30 @@
 #define NEURALNETWORK_H
 
 #include <vector>
+#include <iosfwd>
 #include <cmath>
-#include <cstdlib>
-#include <ctime>
+#include <cstdint>
+#include <string>
 
 // Enums for Network Configuration
 enum class ActivationType { SIGMOID, TANH, LINEAR };
 enum class TaskMode { CLASSIFICATION, REGRESSION };
+enum class InitType { XAVIER, HE, UNIFORM };
+
+// Compressed Sparse Row copy of a pruned weight matrix (one row per neuron)
+struct CsrMatrix {
+    std::vector<int> rowPtr;     // numNeurons + 1 offsets into colIdx/values
+    std::vector<int> colIdx;     // Input index of each kept weight
+    std::vector<double> values;  // Kept weights
+};
+
+// Inference kernel parameters; the Autotuner picks them per machine and topology.
+// Every setting gives bit-identical outputs, only the speed differs.
+struct KernelConfig {
+    int sampleBlock = 4; // Samples sharing one pass over a weight row (vectorized across samples)
+    int batchSize = 64;  // Samples per inferBatch() call in the Evaluator
+    int threads = 0;     // Evaluation threads (0 = whole ThreadPool)
+};
 
 struct Layer {
     int numNeurons;
@@ -18,35 +35,111 @@ struct Layer {
     std::vector<double> deltas;
     std::vector<double> weights;
     std::vector<double> biases;
+
+    // --- Pruning ---
+    std::vector<unsigned char> mask; // 1 = kept, 0 = pruned (empty = never pruned)
+    CsrMatrix sparse;
+    bool sparseValid = false;        // CSR values match 'weights'
+    bool useSparse = false;          // Chosen by selectKernels()
 };
 
 class NeuralNetwork {
 public:
-    NeuralNetwork();
+    static const uint64_t DEFAULT_SEED = 1;
+    explicit NeuralNetwork(uint64_t seed = DEFAULT_SEED);
 
     // Initialization
-    void setup(int inputSize, int hiddenLayers, int neuronsPerLayer, int outputSize, ActivationType actType, TaskMode mode);
-    void reset();
+    // Weights are a pure function of (seed, generation, layer, index): identical for any thread count
+    void setup(int inputSize, int hiddenLayers, int neuronsPerLayer, int outputSize, ActivationType actType, TaskMode mode,
+               InitType init = InitType::XAVIER);
+    void reset(); // New generation of random weights, same architecture
 
     // Core Operations
     std::vector<double> predict(const std::vector<double> &inputs);
     double train(const std::vector<double> &inputs, const std::vector<double> &targets, double learningRate);
 
+    // Thread-safe inference: only reads parameters, activations live in 'scratch'.
+    // Call prepareInference() once beforehand so pruned layers can use their CSR copy.
+    void prepareInference();
+    void infer(const std::vector<double> &inputs, std::vector<double> &outputs, std::vector<double> &scratch) const;
+    // Batched variant: 'count' samples stored back to back in 'inputs';
+    // 'outputs' receives count * outputSize values in the same order
+    void inferBatch(const double *inputs, size_t count, std::vector<double> &outputs, std::vector<double> &scratch) const;
+
+    // Full-batch path for quasi-Newton optimizers. Runs forward and backward over 'count'
+    // samples stored back to back ('targets' holds count * outputSize values), ADDS
+    // dLoss/dParameter to 'gradient' (flat parameter order) and returns the summed
+    // 0.5 * error^2 loss, the scale train() reports. Thread-safe like inferBatch().
+    double lossGradientBatch(const double *inputs, const double *targets, size_t count,
+                             std::vector<double> &gradient, std::vector<double> &scratch) const;
+
+    // Pruning (magnitude based, pruned weights stay zero during training)
+    void prune(int layerIdx, double sparsity);
+    void pruneAll(const std::vector<double> &layerSparsity); // One target per layer, missing = dense
+    double getSparsity(int layerIdx) const;
+    bool isLayerSparse(int layerIdx) const { return layers[layerIdx].useSparse; }
+    void selectKernels(); // Times dense vs CSR per layer and keeps the faster one
+
+    // Cubic schedule: sparsity to reach at 'step' of 'totalSteps'
+    static double pruneSchedule(double finalSparsity, int step, int totalSteps);
+
+    // Per-layer targets from "S" (every hidden layer; the output layer stays dense)
+    // or "s0,s1,..." (exactly one value per layer, output last). Returns false on a
+    // malformed list or a value outside [0, 1).
+    static bool parseLayerSparsity(const std::string &text, int layerCount, std::vector<double> &layerSparsity);
+
+    // Iterative pruning during training: ramps every layer up to its own target over
+    // the first half of the run, the second half lets the remaining weights recover.
+    // Returns true if it pruned.
+    bool applyPruneSchedule(const std::vector<double> &finalSparsity, int epoch, int totalEpochs);
+
+    // Serialization (topology, parameters and pruning masks, native byte order)
+    void save(std::ostream &out) const;
+    bool load(std::istream &in);
+
     // Getters & Accessors
     double getWeight(int layerIdx, int neuronIdx, int weightIdx) const;
     double getBias(int layerIdx, int neuronIdx) const;
     int getLayerCount() const { return (int)layers.size(); }
     int getLayerSize(int i) const { return layers[i].numNeurons; }
+    int getInputSize() const { return layers.empty() ? 0 : layers[0].numWeightsPerNeuron; }
+    int getOutputSize() const { return layers.empty() ? 0 : layers.back().numNeurons; }
+    ActivationType getActivation() const { return activation; }
+    TaskMode getMode() const { return mode; }
+    InitType getInitType() const { return initType; }
+    uint64_t getSeed() const { return seed; }
+    uint64_t getRevision() const { return revision; } // Changes whenever the parameters do (views cache on it)
+    size_t getParameterCount() const;
+
+    // Flat parameter vector: per layer its weights, then its biases
+    void getParameters(std::vector<double> &params) const;
+    void setParameters(const std::vector<double> &params); // Pruned weights stay zero
+
+    // Inference kernels (not serialized: tuning belongs to the machine, not the model)
+    const KernelConfig &getKernelConfig() const { return kernel; }
+    void setKernelConfig(const KernelConfig &config) { kernel = config; }
+
+    // Setters (used to load externally trained parameters)
+    void setWeight(int layerIdx, int neuronIdx, int weightIdx, double value);
+    void setBias(int layerIdx, int neuronIdx, double value);
 
 private:
     std::vector<Layer> layers;
     ActivationType activation;
     TaskMode mode;
+    InitType initType;
+    uint64_t seed;
+    uint64_t generation; // Bumped by reset()
+    uint64_t revision;   // Bumped by every parameter change (not serialized)
+    KernelConfig kernel;
 
     // Internal Helpers
-    double activate(double x);
-    double activateDeriv(double y);
-    double randomWeight();
+    void feedForward(const std::vector<double> &inputs, bool allowSparse);
+    void forwardLayer(const Layer &layer, const double *in, double *out, size_t count, bool sparse, bool linearOut) const;
+    void rebuildSparse(Layer &layer);
+    void initializeLayer(int layerIdx);
+    double activate(double x) const;
+    double activateDeriv(double y) const;
 };
 
 #endif // NEURALNETWORK_H
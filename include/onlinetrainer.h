@@ -0,0 +1,57 @@
+#ifndef ONLINETRAINER_H
+#define ONLINETRAINER_H
+
+#include <vector>
+#include <cstdint>
+#include "neuralnetwork.h"
+#include "dataset.h"
+#include "ingestqueue.h"
+
+struct OnlineConfig {
+    double replayWeight = 8.0; // A new point is drawn this many times as often as an old one...
+    int replayVisits = 64;     // ...until it has been trained on this many times
+    int stepsPerTick = 256;    // Single-sample SGD steps per trainTick()
+};
+
+// Warm-start training on points added while a network already exists.
+// Producers (RenderArea clicks) push into a lock-free queue; the trainer drains
+// it into the live Dataset without rebuilding it, then keeps training the
+// current weights. New points are replayed with extra weight while old ones
+// keep being rehearsed, so the boundary moves to the new points without
+// forgetting the rest.
+class OnlineTrainer {
+public:
+    explicit OnlineTrainer(const OnlineConfig &config = OnlineConfig());
+
+    IngestQueue<DataPoint> &getQueue() { return queue; }
+
+    // Appends every queued point to 'data' (normalized by 'range') and marks it fresh.
+    // Returns the number of points added.
+    size_t drain(Dataset &data, double range);
+
+    // Drops queued points (they are already part of a freshly built data set)
+    void discardPending();
+
+    // Starts over for a (re)built data set: nothing is fresh
+    void reset();
+
+    bool hasFreshPoints() const { return !fresh.empty(); }
+    size_t getFreshCount() const { return fresh.size(); }
+
+    // Runs stepsPerTick weighted SGD steps on the current weights.
+    // Returns the mean loss of the steps taken (0 if there was nothing to do).
+    double trainTick(NeuralNetwork &network, const Dataset &data, double learningRate);
+
+    const OnlineConfig &getConfig() const { return config; }
+    void setConfig(const OnlineConfig &c) { config = c; }
+
+private:
+    OnlineConfig config;
+    IngestQueue<DataPoint> queue;
+    std::vector<size_t> fresh;   // Indices of points still owed replay visits
+    std::vector<int> remaining;  // Replay visits left, parallel to 'fresh'
+    std::vector<double> target;
+    uint64_t drawCounter;        // Position in the ONLINE random stream
+};
+
+#endif // ONLINETRAINER_H
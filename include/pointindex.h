@@ -0,0 +1,46 @@
+#ifndef POINTINDEX_H
+#define POINTINDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "dataset.h"
+
+// Uniform grid over the square [-range, range]^2 (the visible canvas).
+// Each cell lists the indices of the points inside it, so a repaint only
+// touches the cells under the dirty rectangle. Points outside the square
+// can never be on screen and are left out of every query.
+class PointIndex {
+public:
+    static const int CELLS = 128; // Per axis
+
+    PointIndex();
+
+    void build(const std::vector<DataPoint> &points, double range);
+    void add(const DataPoint &p, uint32_t index);
+    void clear();
+
+    size_t getIndexedCount() const { return indexed; } // Points inside the square
+
+    // Calls fn(pointIndex) for every point in the cells overlapping the world rectangle
+    template <typename Fn>
+    void forEachIn(double x0, double y0, double x1, double y1, Fn fn) const {
+        int c0, r0, c1, r1;
+        if (!cellRange(x0, y0, x1, y1, c0, r0, c1, r1)) return;
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                for (uint32_t i : cells[r * CELLS + c]) fn(i);
+            }
+        }
+    }
+
+private:
+    int cellOf(double v) const; // -1 outside [-range, range]
+    bool cellRange(double x0, double y0, double x1, double y1, int &c0, int &r0, int &c1, int &r1) const;
+
+    std::vector<std::vector<uint32_t>> cells; // Row-major, row 0 at y = -range
+    double range;
+    size_t indexed;
+};
+
+#endif // POINTINDEX_H
@@ -0,0 +1,86 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Counter-based random numbers (SplitMix64 finalizer over a keyed counter).
+// Every draw is a pure function of (seed, stream, counter): there is no hidden
+// state to share between threads, and draw i is the same no matter which
+// thread computes it or in which order.
+class CounterRng {
+public:
+    explicit CounterRng(uint64_t seed = 0, uint64_t stream = 0)
+        : key(makeKey(seed, stream)), counter(0) {}
+
+    // --- Stateless Access ---
+    static uint64_t bitsAt(uint64_t seed, uint64_t stream, uint64_t index) {
+        return mix(makeKey(seed, stream) + (index + 1) * 0x9E3779B97F4A7C15ULL);
+    }
+    static double uniformAt(uint64_t seed, uint64_t stream, uint64_t index) {
+        return toUnit(bitsAt(seed, stream, index));
+    }
+    // Box-Muller over the counter pair (2i, 2i+1)
+    static double normalAt(uint64_t seed, uint64_t stream, uint64_t index) {
+        double u1 = toUnit(bitsAt(seed, stream, 2 * index));
+        double u2 = toUnit(bitsAt(seed, stream, 2 * index + 1));
+        return std::sqrt(-2.0 * std::log(1.0 - u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+    // --- Sequential Access ---
+    uint64_t next() { return mix(key + (++counter) * 0x9E3779B97F4A7C15ULL); }
+    double uniform() { return toUnit(next()); }
+
+    // Unbiased integer in [0, n) (Lemire's multiply-shift with rejection)
+    uint32_t below(uint32_t n) {
+        uint64_t m = (next() >> 32) * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = (next() >> 32) * n;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    // Fisher-Yates; the result depends only on (seed, stream)
+    template <typename T>
+    void shuffle(std::vector<T> &items) {
+        for (size_t i = items.size(); i > 1; i--) {
+            size_t j = below((uint32_t)i);
+            std::swap(items[i - 1], items[j]);
+        }
+    }
+
+    uint64_t getCounter() const { return counter; }
+    void setCounter(uint64_t c) { counter = c; }
+
+private:
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    static uint64_t makeKey(uint64_t seed, uint64_t stream) {
+        return mix(seed ^ mix(stream + 0x632BE59BD9B4E019ULL));
+    }
+    // 53 random bits -> [0, 1)
+    static double toUnit(uint64_t bits) { return (bits >> 11) * (1.0 / 9007199254740992.0); }
+
+    uint64_t key;
+    uint64_t counter;
+};
+
+// Streams used by training code, so draws never overlap
+namespace RngStream {
+    const uint64_t SHUFFLE = 0x5348554646000000ULL; // + epoch
+    const uint64_t AUTOTUNE = 0x54554E4500000000ULL; // Synthetic benchmark inputs
+    const uint64_t IMPORTANCE = 0x494D500000000000ULL; // + epoch, importance sampling draws
+    const uint64_t ONLINE = 0x4F4E4C0000000000ULL; // Online replay draws
+}
+
+#endif // RANDOM_H
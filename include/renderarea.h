@@ -2,14 +2,13 @@
 #define RENDERAREA_H
 
 #include <QWidget>
+#include <QImage>
+#include <QPixmap>
 #include <vector>
 #include "neuralnetwork.h"
-
-struct DataPoint {
-    double x; // World Coordinate X
-    double y; // World Coordinate Y
-    int classID;
-};
+#include "dataset.h"
+#include "ingestqueue.h"
+#include "pointindex.h"
 
 class RenderArea : public QWidget {
     Q_OBJECT
@@ -17,34 +16,52 @@ public:
     explicit RenderArea(QWidget *parent = nullptr);
 
     // --- Configuration ---
-    void setNetwork(NeuralNetwork *net) { network = net; }
-    void setRegressionMode(bool active) { isRegression = active; update(); }
+    void setNetwork(NeuralNetwork *net) { network = net; heatmapValid = false; }
+    void setRegressionMode(bool active) { isRegression = active; heatmapValid = false; update(); }
     void setCurrentClass(int c) { currentClass = c; }
     void setVisualizeMode(bool active) { visualizeDecision = active; update(); }
     void setShowLines(bool active) { showNeuronLines = active; update(); }
+    void setIngestQueue(IngestQueue<DataPoint> *queue) { ingestQueue = queue; } // Clicked points are also pushed here
 
     // --- Data Management ---
-    void clearData() { data.clear(); update(); }
+    void clearData();
+    void setData(const std::vector<DataPoint> &points);
     const std::vector<DataPoint>& getData() const { return data; }
+    size_t getVisibleCount() const { return index.getIndexedCount(); } // Points inside the axis range
     double getAxisRange() const { return axisRange; }
+    void setAxisRange(double range); // World units from the center to each edge
 
 protected:
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
 private:
     // --- Drawing Helpers ---
     void drawGrid(QPainter &painter);
-    void drawDataPoints(QPainter &painter);
+    void drawDataPoints(QPainter &painter, const QRect &dirty);
     void drawNeuronLines(QPainter &painter);      // Classification boundaries
     void drawRegressionCurve(QPainter &painter);  // Curve approximation
-    void drawHeatmap(QPainter &painter);          // Decision boundary regions
+    void drawHeatmap(QPainter &painter);          // Decision boundary regions (cached, see rebuildHeatmap)
 
     // --- Coordinate Transformations ---
-    QPoint toScreen(double worldX, double worldY); // Map World -> Screen pixels
-    DataPoint toWorld(int screenX, int screenY);   // Map Screen pixels -> World
+    QPoint toScreen(double worldX, double worldY) const; // Map World -> Screen pixels
+    DataPoint toWorld(int screenX, int screenY) const;   // Map Screen pixels -> World
+    DataPoint toWorld(int screenX, int screenY, const QSize &viewport) const; // Same, no widget access (any thread)
+
+    QColor getClassColor(int classId) const;
+    static int colorSlot(int classId) { return ((classId % COLOR_COUNT) + COLOR_COUNT) % COLOR_COUNT; }
 
-    QColor getClassColor(int classId);
+    // --- Cached Layers ---
+    const QPixmap &gridLayer();                // Grid and axes, redrawn only on resize
+    const QPixmap &markerSprite(int colorIdx); // One pre-rendered point marker per class color
+    void rebuildHeatmap();                     // Runs inference over the canvas into heatmapImage
+    void rebuildDensity();                     // Density image of every visible point
+    void addToDensity(const DataPoint &p);     // Incremental update for a clicked point
+
+    static const int COLOR_COUNT = 6;
+    static const int POINT_RADIUS = 6;
+    static const size_t DENSITY_THRESHOLD = 50000; // More visible points than this: draw density, not markers
 
     // Internal State
     bool isRegression;
@@ -54,6 +71,18 @@ private:
     bool visualizeDecision;
     bool showNeuronLines;
     double axisRange;
+    IngestQueue<DataPoint> *ingestQueue; // Not owned
+
+    PointIndex index;                  // Viewport culling: cells under the dirty rectangle only
+    QPixmap gridCache;
+    QPixmap markerCache[COLOR_COUNT];
+    QImage heatmapImage;
+    uint64_t heatmapRevision;           // Network revision heatmapImage was computed for
+    bool heatmapValid;
+    QImage densityImage;
+    std::vector<uint32_t> densityCount; // Points per pixel
+    std::vector<float> densityColor;    // RGB sums per pixel
+    bool densityValid;
 };
 
 #endif // RENDERAREA_H
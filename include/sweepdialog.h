@@ -0,0 +1,56 @@
+#ifndef SWEEPDIALOG_H
+#define SWEEPDIALOG_H
+
+#include <QDialog>
+#include <vector>
+#include "dataset.h"
+#include "sweepengine.h"
+
+class QThread;
+class QComboBox;
+class QPushButton;
+class QLineEdit;
+class QSpinBox;
+class QCheckBox;
+class QTableWidget;
+class QLabel;
+
+// Hyper-parameter sweep over the current data points.
+// Results are listed best-first; nothing in the main window is modified.
+// Models train on a background thread, the dialog stays responsive meanwhile.
+class SweepDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit SweepDialog(const Dataset &data, QWidget *parent = nullptr);
+    ~SweepDialog();
+
+public slots:
+    void reject() override; // Ignored while a sweep runs
+
+private slots:
+    void runSweep();
+    void onSweepFinished();
+
+private:
+    Dataset dataset;
+    QThread *sweepThread;
+    std::vector<SweepResult> results; // Written by sweepThread, read once it has finished
+
+    // --- Grid Inputs ---
+    QLineEdit *editLearningRates;
+    QLineEdit *editHiddenLayers;
+    QLineEdit *editNeurons;
+    QCheckBox *chkSigmoid;
+    QCheckBox *chkTanh;
+    QSpinBox *spinEpochs;
+    QSpinBox *spinThreads;
+    QSpinBox *spinSeed;
+    QComboBox *cmbInit;
+    QPushButton *btnRun;
+
+    // --- Output ---
+    QTableWidget *tableResults;
+    QLabel *lblStatus;
+};
+
+#endif // SWEEPDIALOG_H
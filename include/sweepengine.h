@@ -0,0 +1,61 @@
+#ifndef SWEEPENGINE_H
+#define SWEEPENGINE_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include "neuralnetwork.h"
+#include "dataset.h"
+
+// One point of the hyper-parameter grid
+struct SweepCandidate {
+    int hiddenLayers;
+    int neuronsPerLayer;
+    ActivationType activation;
+    double learningRate;
+};
+
+struct SweepResult {
+    SweepCandidate candidate;
+    double finalLoss;   // Summed error of the last epoch
+    double wallTimeMs;  // Wall time of the pack this model trained in
+    int group;          // Index of the SIMD pack
+    std::shared_ptr<NeuralNetwork> network; // Trained model
+};
+
+struct SweepConfig {
+    std::vector<SweepCandidate> candidates;
+    int epochs = 1000;
+    int threads = 0; // Max packs trained at once; 0 = every ThreadPool thread
+    InitType init = InitType::XAVIER;
+
+    // Every candidate starts from this seed, so same-shape models begin from
+    // identical weights and only the hyper-parameters differ
+    uint64_t seed = NeuralNetwork::DEFAULT_SEED;
+};
+
+// Trains many independent networks at once.
+// Candidates with the same shape (layers, neurons, activation) are interleaved
+// LANES-wide so one weight loop updates all of them; packs run on the shared ThreadPool.
+// Init is shared on purpose: every candidate is built from config.seed and sees
+// the same sample order, so same-shape candidates start from bit-identical
+// weights and their ranking reflects the hyper-parameters, not a lucky draw.
+// Sweep several seeds to compare inits.
+class SweepEngine {
+public:
+    static const int LANES = 4;
+
+    // Cartesian product of the given parameter lists
+    static std::vector<SweepCandidate> makeGrid(const std::vector<double> &learningRates,
+                                                const std::vector<int> &hiddenLayers,
+                                                const std::vector<int> &neurons,
+                                                const std::vector<ActivationType> &activations);
+
+    // Returns results ranked by final loss (best first)
+    static std::vector<SweepResult> run(const SweepConfig &config, const Dataset &data);
+
+    static std::string formatTable(const std::vector<SweepResult> &results);
+    static const char *activationName(ActivationType act);
+};
+
+#endif // SWEEPENGINE_H
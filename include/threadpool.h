@@ -0,0 +1,99 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// HIGH: training, sweeps, evaluation. LOW: UI refresh (heatmaps).
+// Workers always drain every HIGH queue before touching a LOW one.
+enum class TaskPriority { HIGH = 0, LOW = 1 };
+
+class TaskGroup;
+
+// --- Work-Stealing Scheduler ---
+// One process-wide pool shared by the core, the GUI and the CLI so parallel
+// sections never oversubscribe the machine. Each worker owns a deque per
+// priority: it pops its own work LIFO (cache-warm) and steals FIFO from others.
+class ThreadPool {
+public:
+    // Sizing happens once: configure() only has an effect before the first instance() call.
+    // threads = 0 uses every hardware thread; the caller of wait() counts as one of them.
+    static bool configure(int threads, bool pinToCores);
+    static ThreadPool &instance();
+
+    ~ThreadPool();
+
+    int getThreadCount() const { return (int)workers.size() + 1; }
+    bool isPinned() const { return pinned; }
+
+    // Runs one queued task of 'group' on the calling thread, if any
+    bool runOne(TaskGroup &group);
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup *group;
+    };
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks[2]; // Indexed by TaskPriority
+    };
+
+    ThreadPool(); // Reads the configure() settings
+
+    void submit(Task task, TaskPriority priority);
+    bool popTask(int self, TaskPriority priority, Task &out);
+    bool popGroupTask(int self, const TaskGroup &group, Task &out);
+    void execute(Task &task);
+    void workerLoop(int index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // One per worker, plus one for outside threads
+    std::vector<std::thread> workers;
+    bool pinned;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<int> queued;
+    std::atomic<unsigned> nextQueue; // Round-robin target for outside submissions
+    bool stopping;
+
+    friend class TaskGroup;
+};
+
+// A set of tasks that can be waited on. wait() first runs the group's own
+// queued tasks on the waiting thread, then sleeps until the ones already
+// running elsewhere finish. It never picks up another group's task, so a
+// waiter is not held up by unrelated work, and groups can nest (a task may
+// open its own group) without deadlocking.
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPriority priority = TaskPriority::HIGH, ThreadPool &pool = ThreadPool::instance());
+    ~TaskGroup() { wait(); }
+
+    void run(std::function<void()> fn);
+    void wait();
+
+private:
+    ThreadPool &pool;
+    TaskPriority priority;
+    std::atomic<int> pending;   // Decremented under doneMutex, see ThreadPool::execute()
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    friend class ThreadPool;
+};
+
+// Calls body(chunkBegin, chunkEnd) over [begin, end) in chunks of at least 'grain'.
+// Ranges that fit in one chunk run inline without touching the scheduler.
+void parallelFor(size_t begin, size_t end, size_t grain,
+                 const std::function<void(size_t, size_t)> &body,
+                 TaskPriority priority = TaskPriority::HIGH);
+
+#endif // THREADPOOL_H
@@ -0,0 +1,27 @@
+// Global operator new replacement that counts heap allocations.
+// Only compiled in with CONFIG += alloc_metrics (NEURONLAB_ALLOC_METRICS).
+#include "metrics.h"
+
+#ifdef NEURONLAB_ALLOC_METRICS
+#include <cstdlib>
+#include <new>
+
+namespace {
+MetricCounter allocations; // Constant-initialized, usable before main()
+}
+
+MetricCounter &allocationCounter() {
+    return allocations;
+}
+
+void *operator new(std::size_t size) {
+    allocations.inc();
+    if (void *p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void *operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+#endif
@@ -0,0 +1,35 @@
+#include "atomicfile.h"
+#include <cstdio>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+bool writeFileAtomically(const std::string &path, const std::string &bytes) {
+    std::string tmpPath = path + ".tmp";
+    FILE *f = fopen(tmpPath.c_str(), "wb");
+    if (!f) return false;
+
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    ok = ok && fflush(f) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(f)) == 0;
+#else
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = (fclose(f) == 0) && ok;
+    if (!ok) {
+        remove(tmpPath.c_str());
+        return false;
+    }
+
+#ifdef _WIN32
+    return MoveFileExA(tmpPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(tmpPath.c_str(), path.c_str()) == 0;
+#endif
+}
@@ -0,0 +1,225 @@
+#include "autotuner.h"
+#include "atomicfile.h"
+#include "evaluator.h"
+#include "random.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#endif
+
+// --- TuningCache ---
+
+TuningCache &TuningCache::instance() {
+    static TuningCache cache;
+    return cache;
+}
+
+bool TuningCache::load(const std::string &cachePath) {
+    std::lock_guard<std::mutex> lock(mutex);
+    path = cachePath;
+    entries.clear();
+
+    std::ifstream in(cachePath);
+    if (!in) return false;
+
+    // "<key>\t<sampleBlock> <batchSize> <threads>"
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t tab = line.rfind('\t');
+        if (tab == std::string::npos) continue;
+
+        KernelConfig config;
+        std::istringstream values(line.substr(tab + 1));
+        if (!(values >> config.sampleBlock >> config.batchSize >> config.threads)) continue;
+        entries[line.substr(0, tab)] = config;
+    }
+    return true;
+}
+
+bool TuningCache::save() const {
+    std::string out = "# NeuronLab kernel tuning cache: <cpu>|<threads>t|<shape>\t<sampleBlock> <batchSize> <threads>\n";
+    std::string target;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (path.empty()) return false;
+        target = path;
+        for (const auto &e : entries) {
+            out += e.first + "\t" + std::to_string(e.second.sampleBlock) + " " +
+                   std::to_string(e.second.batchSize) + " " + std::to_string(e.second.threads) + "\n";
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(target).parent_path(), ec);
+    return writeFileAtomically(target, out);
+}
+
+bool TuningCache::lookup(const std::string &key, KernelConfig &out) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void TuningCache::store(const std::string &key, const KernelConfig &config) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries[key] = config;
+}
+
+std::string TuningCache::getPath() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return path;
+}
+
+// --- Autotuner ---
+
+std::string Autotuner::cpuModel() {
+    std::string model;
+#if defined(_WIN32)
+    char name[256] = {};
+    DWORD size = sizeof(name);
+    if (RegGetValueA(HKEY_LOCAL_MACHINE, "HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                     "ProcessorNameString", RRF_RT_REG_SZ, nullptr, name, &size) == ERROR_SUCCESS) {
+        model = name;
+    }
+#elif defined(__APPLE__)
+    char name[256] = {};
+    size_t size = sizeof(name);
+    if (sysctlbyname("machdep.cpu.brand_string", name, &size, nullptr, 0) == 0) model = name;
+#else
+    // x86 reports "model name", many ARM kernels only "CPU part"
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line) && model.empty()) {
+        if (line.compare(0, 10, "model name") == 0 || line.compare(0, 8, "CPU part") == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) model = line.substr(colon + 1);
+        }
+    }
+#endif
+
+    // Trim, and keep the cache's separators out of the key
+    std::replace(model.begin(), model.end(), '\t', ' ');
+    std::replace(model.begin(), model.end(), '|', ' ');
+    size_t first = model.find_first_not_of(' ');
+    size_t last = model.find_last_not_of(' ');
+    return first == std::string::npos ? "unknown-cpu" : model.substr(first, last - first + 1);
+}
+
+std::string Autotuner::cacheKey(const NeuralNetwork &network) {
+    // The thread count is part of the key: a config tuned for 16 threads says little about 4
+    std::string key = cpuModel() + "|" + std::to_string(ThreadPool::instance().getThreadCount()) + "t|" +
+                      std::to_string(network.getInputSize());
+    for (int i = 0; i < network.getLayerCount(); i++) key += "-" + std::to_string(network.getLayerSize(i));
+    return key;
+}
+
+std::string Autotuner::defaultCachePath() {
+#ifdef _WIN32
+    const char *base = getenv("APPDATA");
+    return std::string(base ? base : ".") + "\\NeuronLab\\kernel-tuning.txt";
+#else
+    const char *xdg = getenv("XDG_CONFIG_HOME");
+    const char *home = getenv("HOME");
+    std::string base = (xdg && *xdg) ? xdg : std::string(home ? home : ".") + "/.config";
+    return base + "/neuronlab/kernel-tuning.txt";
+#endif
+}
+
+std::string Autotuner::describe(const KernelConfig &config) {
+    char text[96];
+    snprintf(text, sizeof(text), "block %d, batch %d, threads %s", config.sampleBlock, config.batchSize,
+             config.threads > 0 ? std::to_string(config.threads).c_str() : "all");
+    return text;
+}
+
+KernelConfig Autotuner::tune(const NeuralNetwork &network, TaskPriority priority, double *nsPerSample) {
+    KernelConfig best;
+    if (network.getLayerCount() == 0) return best;
+
+    // Tune on a copy so the caller's network is never touched
+    NeuralNetwork probe = network;
+    probe.prepareInference();
+
+    // ~2M multiply-adds per run: long enough to time, short enough for ~100 runs
+    size_t params = std::max<size_t>(1, probe.getParameterCount());
+    size_t samples = std::min<size_t>(4096, std::max<size_t>(64, 2000000 / params));
+
+    Dataset data;
+    data.mode = probe.getMode();
+    data.inputSize = probe.getInputSize();
+    data.outputSize = probe.getOutputSize();
+    data.inputs.resize(samples);
+    for (size_t s = 0; s < samples; s++) {
+        data.inputs[s].resize(data.inputSize);
+        for (int i = 0; i < data.inputSize; i++) {
+            data.inputs[s][i] = CounterRng::uniformAt(network.getSeed(), RngStream::AUTOTUNE, s * data.inputSize + i) * 2.0 - 1.0;
+        }
+    }
+    data.labels.assign(samples, 0);
+    data.values.assign(samples, 0.0);
+
+    // --- Candidate Grid ---
+    int poolThreads = ThreadPool::instance().getThreadCount();
+    std::vector<int> threadOptions = { 1 };
+    if (poolThreads > 2) threadOptions.push_back(poolThreads / 2);
+    if (poolThreads > 1) threadOptions.push_back(0);
+
+    double bestTime = 1e300;
+    for (int block : { 1, 2, 4, 8 }) {
+        for (int batch : { 16, 64, 256 }) {
+            for (int threads : threadOptions) {
+                KernelConfig candidate;
+                candidate.sampleBlock = block;
+                candidate.batchSize = batch;
+                candidate.threads = threads;
+                probe.setKernelConfig(candidate);
+
+                // Best of three after a warm-up run
+                Evaluator::evaluate(probe, data, priority);
+                double time = 1e300;
+                for (int rep = 0; rep < 3; rep++) time = std::min(time, Evaluator::evaluate(probe, data, priority).wallTimeMs);
+
+                if (time < bestTime) {
+                    bestTime = time;
+                    best = candidate;
+                }
+            }
+        }
+    }
+
+    if (nsPerSample) *nsPerSample = bestTime * 1e6 / samples;
+    return best;
+}
+
+bool Autotuner::apply(NeuralNetwork &network, bool tuneIfMissing, TaskPriority priority) {
+    if (network.getLayerCount() == 0) return false;
+
+    TuningCache &cache = TuningCache::instance();
+    std::string key = cacheKey(network);
+
+    KernelConfig config;
+    if (!cache.lookup(key, config)) {
+        if (!tuneIfMissing) {
+            network.setKernelConfig(KernelConfig());
+            return false;
+        }
+        config = tune(network, priority);
+        cache.store(key, config);
+        cache.save();
+    }
+    network.setKernelConfig(config);
+    return true;
+}
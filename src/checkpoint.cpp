@@ -0,0 +1,236 @@
+#include "checkpoint.h"
+#include "atomicfile.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+
+const char MAGIC[4] = { 'N', 'L', 'C', 'K' };
+const uint32_t VERSION = 6; // 3: importance sampling state, 4: optimizer and L-BFGS history,
+                            // 5: per-layer sparsity, 6: axis range
+
+template <typename T>
+void writeValue(std::ostream &out, const T &v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream &in, T &v) {
+    return (bool)in.read(reinterpret_cast<char*>(&v), sizeof(T));
+}
+
+// True when 'count' records of 'recordSize' bytes fit in the rest of the file,
+// so a corrupt count is rejected before anything is allocated
+bool fitsRemaining(std::istream &in, const std::string &bytes, uint64_t count, size_t recordSize) {
+    std::streamoff pos = in.tellg();
+    if (pos < 0 || (uint64_t)pos > bytes.size()) return false;
+    return count <= (bytes.size() - (uint64_t)pos) / recordSize;
+}
+
+std::string serialize(const TrainingState &state) {
+    std::ostringstream out(std::ios::binary);
+    out.write(MAGIC, 4);
+    writeValue<uint32_t>(out, VERSION);
+
+    writeValue<int32_t>(out, state.epoch);
+    writeValue<int32_t>(out, state.maxEpochs);
+    writeValue<double>(out, state.learningRate);
+    writeValue<uint32_t>(out, (uint32_t)state.pruneSparsity.size());
+    for (double sparsity : state.pruneSparsity) writeValue<double>(out, sparsity);
+    writeValue<uint64_t>(out, state.seed);
+    writeValue<double>(out, state.axisRange);
+
+    writeValue<uint32_t>(out, (uint32_t)state.points.size());
+    for (const auto &p : state.points) {
+        writeValue<double>(out, p.x);
+        writeValue<double>(out, p.y);
+        writeValue<int32_t>(out, p.classID);
+    }
+
+    writeValue<uint32_t>(out, (uint32_t)state.errorHistory.size());
+    for (double e : state.errorHistory) writeValue<double>(out, e);
+
+    writeValue<uint8_t>(out, state.importanceSampling ? 1 : 0);
+    writeValue<double>(out, state.importanceFraction);
+    writeValue<int32_t>(out, state.fullSweepInterval);
+    writeValue<uint32_t>(out, (uint32_t)state.sampleLosses.size());
+    for (double l : state.sampleLosses) writeValue<double>(out, l);
+
+    writeValue<uint8_t>(out, (uint8_t)state.optimizer);
+    writeValue<uint32_t>(out, (uint32_t)std::min(state.lbfgsS.size(), state.lbfgsY.size()));
+    for (size_t k = 0; k < state.lbfgsS.size() && k < state.lbfgsY.size(); k++) {
+        writeValue<uint32_t>(out, (uint32_t)state.lbfgsS[k].size());
+        for (double v : state.lbfgsS[k]) writeValue<double>(out, v);
+        for (double v : state.lbfgsY[k]) writeValue<double>(out, v);
+    }
+
+    state.network.save(out);
+    return out.str();
+}
+
+bool deserialize(const std::string &bytes, TrainingState &state) {
+    std::istringstream in(bytes, std::ios::binary);
+    char magic[4];
+    uint32_t version = 0;
+    if (!in.read(magic, 4) || !std::equal(magic, magic + 4, MAGIC)) return false;
+    if (!readValue(in, version) || version < 2 || version > VERSION) return false;
+
+    TrainingState s;
+    int32_t epoch = 0, maxEpochs = 0;
+    if (!readValue(in, epoch) || !readValue(in, maxEpochs)) return false;
+    if (!readValue(in, s.learningRate)) return false;
+
+    // Version 4 and older stored one sparsity for every layer
+    uint32_t count = 0;
+    double sharedSparsity = 0.0;
+    if (version >= 5) {
+        if (!readValue(in, count) || !fitsRemaining(in, bytes, count, sizeof(double))) return false;
+        s.pruneSparsity.resize(count);
+        for (double &sparsity : s.pruneSparsity) {
+            if (!readValue(in, sparsity)) return false;
+        }
+    } else if (!readValue(in, sharedSparsity)) {
+        return false;
+    }
+
+    if (!readValue(in, s.seed)) return false;
+    s.axisRange = 0.0; // Unknown before version 6: the caller picks the range
+    if (version >= 6 && (!readValue(in, s.axisRange) || !(s.axisRange > 0.0))) return false;
+    s.epoch = epoch;
+    s.maxEpochs = maxEpochs;
+
+    if (!readValue(in, count) || !fitsRemaining(in, bytes, count, 2 * sizeof(double) + sizeof(int32_t))) return false;
+    s.points.resize(count);
+    for (auto &p : s.points) {
+        int32_t classID = 0;
+        if (!readValue(in, p.x) || !readValue(in, p.y) || !readValue(in, classID)) return false;
+        p.classID = classID;
+    }
+
+    if (!readValue(in, count) || !fitsRemaining(in, bytes, count, sizeof(double))) return false;
+    s.errorHistory.resize(count);
+    for (double &e : s.errorHistory) {
+        if (!readValue(in, e)) return false;
+    }
+
+    // Version 2 files predate importance sampling and keep the defaults
+    if (version >= 3) {
+        uint8_t importance = 0;
+        int32_t interval = 0;
+        if (!readValue(in, importance) || !readValue(in, s.importanceFraction) || !readValue(in, interval)) return false;
+        s.importanceSampling = importance != 0;
+        s.fullSweepInterval = interval;
+
+        if (!readValue(in, count) || !fitsRemaining(in, bytes, count, sizeof(double))) return false;
+        s.sampleLosses.resize(count);
+        for (double &l : s.sampleLosses) {
+            if (!readValue(in, l)) return false;
+        }
+    }
+
+    // Version 3 and older were always plain SGD
+    if (version >= 4) {
+        uint8_t optimizer = 0;
+        if (!readValue(in, optimizer) || optimizer > (uint8_t)OptimizerType::LBFGS) return false;
+        s.optimizer = (OptimizerType)optimizer;
+
+        uint32_t pairs = 0;
+        if (!readValue(in, pairs) || !fitsRemaining(in, bytes, pairs, sizeof(uint32_t))) return false;
+        s.lbfgsS.resize(pairs);
+        s.lbfgsY.resize(pairs);
+        for (uint32_t k = 0; k < pairs; k++) {
+            if (!readValue(in, count) || !fitsRemaining(in, bytes, count, 2 * sizeof(double))) return false;
+            s.lbfgsS[k].resize(count);
+            s.lbfgsY[k].resize(count);
+            for (double &v : s.lbfgsS[k]) {
+                if (!readValue(in, v)) return false;
+            }
+            for (double &v : s.lbfgsY[k]) {
+                if (!readValue(in, v)) return false;
+            }
+        }
+    }
+
+    if (!s.network.load(in)) return false;
+    if (sharedSparsity > 0.0) s.pruneSparsity.assign(s.network.getLayerCount(), sharedSparsity);
+
+    state = std::move(s);
+    return true;
+}
+
+} // namespace
+
+// --- Checkpoint ---
+
+bool Checkpoint::save(const std::string &path, const TrainingState &state) {
+    return writeFileAtomically(path, serialize(state));
+}
+
+bool Checkpoint::load(const std::string &path, TrainingState &state) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+
+    std::string bytes;
+    char buffer[65536];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), f)) > 0) bytes.append(buffer, n);
+    fclose(f);
+
+    return deserialize(bytes, state);
+}
+
+// --- CheckpointWriter ---
+
+CheckpointWriter::CheckpointWriter(const std::string &filePath)
+    : path(filePath), stopping(false), failed(false), written(0)
+{
+    worker = std::thread(&CheckpointWriter::run, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void CheckpointWriter::submit(std::unique_ptr<TrainingState> state) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.swap(state); // Replaces a snapshot the writer has not picked up yet
+    }
+    wake.notify_one();
+    // A dropped snapshot is freed here, outside the lock
+}
+
+int CheckpointWriter::getWrittenCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return written;
+}
+
+bool CheckpointWriter::hasFailed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
+
+void CheckpointWriter::run() {
+    for (;;) {
+        std::unique_ptr<TrainingState> state;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || pending; });
+            if (!pending && stopping) return;
+            state = std::move(pending);
+        }
+
+        bool ok = Checkpoint::save(path, *state);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ok) written++;
+        else failed = true;
+    }
+}
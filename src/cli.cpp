@@ -0,0 +1,548 @@
+// Headless command line front-end (no Qt dependency).
+//
+// Usage:
+//   NeuoronLabCli sweep --data points.csv [options]
+//   NeuoronLabCli train --data points.csv [options]
+//   NeuoronLabCli evaluate --model run.nlck [--data test.csv]
+//   NeuoronLabCli check-gradient [--data points.csv] [options]
+//
+// Common options:
+//   --data FILE        "x,y,class" (or "x,y" with --regression) points
+//   --regression       Treat points as X -> Y regression
+//   --range R          Axis range used to normalize points (default 10); stored in
+//                      checkpoints, --resume and evaluate reject a different value
+//   --classes N        Output count (default: highest class + 1)
+//   --epochs N         Epochs per model (default 1000)
+//   --metrics-port P   Serve OpenMetrics on http://127.0.0.1:P/metrics
+//   --metrics-file F   Rewrite F with OpenMetrics text every 5 seconds
+//   --threads N        Size of the shared thread pool (default: all cores)
+//   --pin              Pin pool workers to cores
+//   --autotune         Benchmark inference kernels for this topology if the
+//                      per-machine tuning cache has no entry yet
+//   --tuning-cache F   Tuning cache file (default: ~/.config/neuronlab/kernel-tuning.txt)
+//
+// sweep options (comma separated lists):
+//   --lr a,b,..        Learning rates (default 0.1,0.05,0.01,0.005)
+//   --layers a,b,..    Hidden layer counts (default 0,1,2)
+//   --neurons a,b,..   Neurons per hidden layer (default 4,8)
+//   --act a,b,..       SIGMOID and/or TANH (default both)
+//   --seed N           Initialization / shuffle seed (default 1)
+//   --init NAME        XAVIER (default), HE or UNIFORM
+//
+// train options:
+//   --lr X --layers N --neurons N --act NAME --seed N --init NAME
+//   --prune S          Target sparsity (0..1) of every hidden layer, pruned iteratively;
+//                      the output layer stays dense
+//   --prune a,b,..     One target per layer instead, output layer last
+//   --checkpoint FILE  Write crash-safe snapshots in the background
+//   --checkpoint-every SECONDS (default 5)
+//   --resume FILE      Continue exactly from a checkpoint (no --data needed)
+//   --images F --labels F  Train on an IDX (MNIST) pair instead of --data;
+//                      checkpoints then hold no points, pass them again on --resume
+//   --importance       Hard-example importance sampling between full sweeps
+//   --importance-fraction F  Share of samples drawn per importance epoch (default 0.25)
+//   --full-sweep-every N     Unweighted full sweep every N epochs (default 10)
+//   --optimizer NAME   SGD (default) or LBFGS: full-batch quasi-Newton, one
+//                      iteration per epoch, stops early once converged
+//                      (ignores --lr and --importance)
+//   --test FILE        Score a held-out point file after training
+//   --test-images F --test-labels F  Score a held-out IDX pair after training
+//
+// evaluate options:
+//   --model FILE       Checkpoint to score
+//   --data FILE / --images F --labels F  Test set (default: the checkpoint's points)
+//
+// check-gradient options (self test of the L-BFGS path, exits 1 on a mismatch):
+//   Without --data: built-in classification, regression and pruned cases.
+//   With --data: one network from --layers --neurons --act --seed --init --prune.
+//   --tolerance X      Largest allowed gradient error (default 1e-6, relative to
+//                      max(1, |analytic| + |numeric|))
+
+#include "neuralnetwork.h"
+#include "dataset.h"
+#include "sweepengine.h"
+#include "checkpoint.h"
+#include "metrics.h"
+#include "evaluator.h"
+#include "autotuner.h"
+#include "importancesampler.h"
+#include "lbfgs.h"
+#include "threadpool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    std::string command;
+    std::map<std::string, std::string> values;
+
+    bool has(const std::string &key) const { return values.count(key) > 0; }
+    std::string get(const std::string &key, const std::string &def) const {
+        auto it = values.find(key);
+        return it == values.end() ? def : it->second;
+    }
+    int getInt(const std::string &key, int def) const { return has(key) ? atoi(values.at(key).c_str()) : def; }
+    double getDouble(const std::string &key, double def) const { return has(key) ? atof(values.at(key).c_str()) : def; }
+};
+
+// Flags without a value (e.g. --regression) are stored as "1"
+Options parseArgs(int argc, char *argv[]) {
+    Options opt;
+    if (argc > 1) opt.command = argv[1];
+
+    for (int i = 2; i < argc; i++) {
+        if (strncmp(argv[i], "--", 2) != 0) continue;
+        std::string key = argv[i] + 2;
+        if (i + 1 < argc && strncmp(argv[i+1], "--", 2) != 0) {
+            opt.values[key] = argv[++i];
+        } else {
+            opt.values[key] = "1";
+        }
+    }
+    return opt;
+}
+
+std::vector<std::string> splitList(const std::string &text) {
+    std::vector<std::string> items;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+ActivationType parseActivation(const std::string &name) {
+    return (name == "TANH" || name == "tanh") ? ActivationType::TANH : ActivationType::SIGMOID;
+}
+
+InitType parseInit(const std::string &name) {
+    if (name == "HE" || name == "he") return InitType::HE;
+    if (name == "UNIFORM" || name == "uniform") return InitType::UNIFORM;
+    return InitType::XAVIER;
+}
+
+OptimizerType parseOptimizer(const std::string &name) {
+    if (name == "LBFGS" || name == "lbfgs" || name == "L-BFGS") return OptimizerType::LBFGS;
+    return OptimizerType::SGD;
+}
+
+uint64_t parseSeed(const Options &opt) {
+    return opt.has("seed") ? strtoull(opt.get("seed", "").c_str(), nullptr, 10) : NeuralNetwork::DEFAULT_SEED;
+}
+
+bool loadPoints(const Options &opt, std::vector<DataPoint> &points) {
+    std::string path = opt.get("data", "");
+    if (path.empty() || !Dataset::loadPoints(path, points) || points.empty()) {
+        fprintf(stderr, "Could not read data points from '%s'\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+double parseRange(const Options &opt) {
+    return opt.getDouble("range", 10.0);
+}
+
+Dataset buildDataset(const Options &opt, const std::vector<DataPoint> &points) {
+    TaskMode mode = opt.has("regression") ? TaskMode::REGRESSION : TaskMode::CLASSIFICATION;
+    int maxClass = 0;
+    for (const auto &p : points) maxClass = std::max(maxClass, p.classID);
+
+    return Dataset::fromPoints(points, parseRange(opt), mode, opt.getInt("classes", maxClass + 1));
+}
+
+// Inputs must be scaled exactly as in training: the checkpoint's range wins and a
+// different --range is an error. Checkpoints older than version 6 take --range.
+bool restoreRange(const Options &opt, TrainingState &state) {
+    if (state.axisRange <= 0.0) {
+        state.axisRange = parseRange(opt);
+    } else if (opt.has("range") && parseRange(opt) != state.axisRange) {
+        fprintf(stderr, "Checkpoint was trained with --range %g, not %g\n", state.axisRange, parseRange(opt));
+        return false;
+    }
+    return true;
+}
+
+bool loadIdx(const Options &opt, const std::string &imagesKey, const std::string &labelsKey, Dataset &ds) {
+    std::string images = opt.get(imagesKey, ""), labels = opt.get(labelsKey, "");
+    if (!Dataset::loadIdx(images, labels, ds) || ds.empty()) {
+        fprintf(stderr, "Could not read IDX files '%s' / '%s'\n", images.c_str(), labels.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Points are scaled and one-hot encoded the way 'net' was trained
+Dataset datasetFor(double range, const NeuralNetwork &net, const std::vector<DataPoint> &points) {
+    return Dataset::fromPoints(points, range, net.getMode(), net.getOutputSize());
+}
+
+// Cached (or, with --autotune, freshly tuned) inference kernels for this machine
+void applyKernels(const Options &opt, NeuralNetwork &net) {
+    if (Autotuner::apply(net, opt.has("autotune"))) {
+        printf("Inference kernels: %s\n", Autotuner::describe(net.getKernelConfig()).c_str());
+    }
+}
+
+void printEvaluation(const char *title, NeuralNetwork &net, const Dataset &ds) {
+    net.prepareInference();
+    EvaluationResult result = Evaluator::evaluate(net, ds);
+    printf("\n--- %s ---\n%s", title, result.format().c_str());
+}
+
+int runSweep(const Options &opt) {
+    std::vector<DataPoint> points;
+    if (!loadPoints(opt, points)) return 1;
+    Dataset ds = buildDataset(opt, points);
+
+    std::vector<double> lrs;
+    std::vector<int> layers, neurons;
+    std::vector<ActivationType> acts;
+
+    for (const auto &s : splitList(opt.get("lr", "0.1,0.05,0.01,0.005"))) lrs.push_back(atof(s.c_str()));
+    for (const auto &s : splitList(opt.get("layers", "0,1,2"))) layers.push_back(atoi(s.c_str()));
+    for (const auto &s : splitList(opt.get("neurons", "4,8"))) neurons.push_back(atoi(s.c_str()));
+    for (const auto &s : splitList(opt.get("act", "SIGMOID,TANH"))) acts.push_back(parseActivation(s));
+
+    SweepConfig config;
+    config.candidates = SweepEngine::makeGrid(lrs, layers, neurons, acts);
+    config.epochs = opt.getInt("epochs", 1000);
+    config.init = parseInit(opt.get("init", "XAVIER"));
+    config.seed = parseSeed(opt);
+
+    printf("Sweeping %zu models on %zu samples, %d epochs each...\n",
+           config.candidates.size(), ds.size(), config.epochs);
+
+    auto results = SweepEngine::run(config, ds);
+    printf("%s", SweepEngine::formatTable(results).c_str());
+    return 0;
+}
+
+int runTrain(const Options &opt) {
+    // Start from a checkpoint or from a fresh network
+    TrainingState state;
+    Dataset ds;
+    bool idx = opt.has("images");
+    if (idx && !loadIdx(opt, "images", "labels", ds)) return 1;
+
+    if (opt.has("resume")) {
+        if (!Checkpoint::load(opt.get("resume", ""), state)) {
+            fprintf(stderr, "Could not read checkpoint '%s'\n", opt.get("resume", "").c_str());
+            return 1;
+        }
+        if (!restoreRange(opt, state)) return 1;
+        printf("Resuming at epoch %d of %d\n", state.epoch, state.maxEpochs);
+    } else {
+        state.axisRange = parseRange(opt);
+        if (!(state.axisRange > 0.0)) {
+            fprintf(stderr, "--range must be positive\n");
+            return 1;
+        }
+        if (!idx) {
+            if (!loadPoints(opt, state.points)) return 1;
+            ds = buildDataset(opt, state.points);
+        }
+
+        state.seed = parseSeed(opt);
+        state.network = NeuralNetwork(state.seed);
+        state.network.setup(ds.inputSize, opt.getInt("layers", 1), opt.getInt("neurons", 8), opt.getInt("classes", ds.outputSize),
+                            parseActivation(opt.get("act", "SIGMOID")), ds.mode, parseInit(opt.get("init", "XAVIER")));
+        state.maxEpochs = opt.getInt("epochs", 1000);
+        state.learningRate = opt.getDouble("lr", 0.05);
+        if (!NeuralNetwork::parseLayerSparsity(opt.get("prune", ""), state.network.getLayerCount(), state.pruneSparsity)) {
+            fprintf(stderr, "--prune needs one sparsity or one per layer (%d), each in [0, 1)\n",
+                    state.network.getLayerCount());
+            return 1;
+        }
+        state.importanceSampling = opt.has("importance");
+        state.importanceFraction = opt.getDouble("importance-fraction", state.importanceFraction);
+        state.fullSweepInterval = opt.getInt("full-sweep-every", state.fullSweepInterval);
+        state.optimizer = parseOptimizer(opt.get("optimizer", "SGD"));
+    }
+
+    NeuralNetwork &net = state.network;
+    applyKernels(opt, net);
+    if (idx) ds.outputSize = net.getOutputSize(); // One-hot width follows the network
+    else ds = datasetFor(state.axisRange, net, state.points);
+    if (ds.inputSize != net.getInputSize() || ds.empty()) {
+        fprintf(stderr, "Training data does not match the network (%d inputs)\n", net.getInputSize());
+        return 1;
+    }
+    double targetMin = Dataset::targetMinFor(net.getActivation());
+
+    // Periodic snapshots go to a background writer
+    std::unique_ptr<CheckpointWriter> writer;
+    if (opt.has("checkpoint")) writer.reset(new CheckpointWriter(opt.get("checkpoint", "")));
+    auto checkpointInterval = std::chrono::duration<double>(opt.getDouble("checkpoint-every", 5.0));
+    auto lastCheckpoint = std::chrono::steady_clock::now();
+
+    int reportInterval = std::max(1, state.maxEpochs / 10);
+    std::vector<double> target;
+    std::vector<size_t> order;
+
+    CoreMetrics &metrics = CoreMetrics::get();
+
+    ImportanceConfig importanceConfig;
+    importanceConfig.sampleFraction = state.importanceFraction;
+    importanceConfig.fullSweepInterval = state.fullSweepInterval;
+    ImportanceSampler sampler(importanceConfig);
+    sampler.setLosses(state.sampleLosses);
+    size_t samplesProcessed = 0;
+    size_t epochsRun = 0;
+
+    LbfgsOptimizer lbfgs;
+    lbfgs.setHistory(state.lbfgsS, state.lbfgsY);
+    bool converged = false;
+
+    while (state.epoch < state.maxEpochs && !converged) {
+        int epoch = state.epoch;
+        auto epochStart = std::chrono::steady_clock::now();
+        net.applyPruneSchedule(state.pruneSparsity, epoch, state.maxEpochs);
+
+        double epochError = 0.0;
+        size_t epochSamples = ds.size();
+        if (state.optimizer == OptimizerType::LBFGS) {
+            epochError = lbfgs.step(net, ds);
+            epochSamples = ds.size() * lbfgs.getLastEvaluations();
+            lbfgs.getHistory(state.lbfgsS, state.lbfgsY);
+            converged = lbfgs.hasConverged();
+        } else if (state.importanceSampling) {
+            epochError = sampler.trainEpoch(net, ds, state.learningRate, state.seed, epoch);
+            epochSamples = sampler.getLastSampleCount();
+            state.sampleLosses = sampler.getLosses();
+        } else {
+            ds.epochOrder(state.seed, epoch, order);
+            for (size_t i : order) {
+                ds.buildTarget(i, targetMin, target);
+                epochError += net.train(ds.inputs[i], target, state.learningRate);
+            }
+        }
+        samplesProcessed += epochSamples;
+        epochsRun++;
+        state.errorHistory.push_back(epochError);
+        state.epoch++;
+
+        auto now = std::chrono::steady_clock::now();
+        metrics.recordEpoch(epochSamples, std::chrono::duration<double>(now - epochStart).count(), epochError);
+
+        bool last = state.epoch == state.maxEpochs || converged;
+        if (epoch % reportInterval == 0 || last) {
+            printf("Epoch %6d  Error %.6f\n", epoch, epochError);
+        }
+
+        if (writer && (now - lastCheckpoint >= checkpointInterval || last)) {
+            writer->submit(std::unique_ptr<TrainingState>(new TrainingState(state)));
+            lastCheckpoint = now;
+        }
+    }
+
+    if (converged) printf("L-BFGS converged after %d iterations\n", state.epoch);
+
+    if (state.importanceSampling && state.optimizer == OptimizerType::SGD) {
+        printf("Importance sampling: %zu samples trained (%.1f%% of plain SGD)\n", samplesProcessed,
+               100.0 * samplesProcessed / std::max<size_t>(1, ds.size() * epochsRun));
+    }
+
+    if (std::any_of(state.pruneSparsity.begin(), state.pruneSparsity.end(), [](double s) { return s > 0.0; })) {
+        net.selectKernels();
+        for (int i = 0; i < net.getLayerCount(); i++) {
+            printf("Layer %d: %5.1f%% sparse, %s kernel\n", i, net.getSparsity(i) * 100.0,
+                   net.isLayerSparse(i) ? "CSR" : "dense");
+        }
+    }
+
+    if (writer) {
+        std::string path = writer->getPath();
+        writer.reset(); // Flush the last snapshot
+        printf("Checkpoint written to %s\n", path.c_str());
+    }
+
+    // --- Evaluation ---
+    printEvaluation("Training set", net, ds);
+    if (opt.has("test")) {
+        std::vector<DataPoint> testPoints;
+        if (!Dataset::loadPoints(opt.get("test", ""), testPoints) || testPoints.empty()) {
+            fprintf(stderr, "Could not read test points from '%s'\n", opt.get("test", "").c_str());
+            return 1;
+        }
+        printEvaluation("Test set", net, datasetFor(state.axisRange, net, testPoints));
+    }
+    if (opt.has("test-images")) {
+        Dataset test;
+        if (!loadIdx(opt, "test-images", "test-labels", test)) return 1;
+        printEvaluation("Test set", net, test);
+    }
+    return 0;
+}
+
+int runEvaluate(const Options &opt) {
+    TrainingState state;
+    if (!Checkpoint::load(opt.get("model", ""), state)) {
+        fprintf(stderr, "Could not read checkpoint '%s'\n", opt.get("model", "").c_str());
+        return 1;
+    }
+    if (!restoreRange(opt, state)) return 1;
+    NeuralNetwork &net = state.network;
+    applyKernels(opt, net);
+
+    // Test set: IDX pair, point file, or the points the model was trained on
+    Dataset ds;
+    if (opt.has("images")) {
+        if (!loadIdx(opt, "images", "labels", ds)) return 1;
+    } else {
+        std::vector<DataPoint> points = state.points;
+        if (opt.has("data")) {
+            points.clear();
+            if (!loadPoints(opt, points)) return 1;
+        }
+        ds = datasetFor(state.axisRange, net, points);
+    }
+
+    if (ds.empty() || ds.inputSize != net.getInputSize()) {
+        fprintf(stderr, "Test set does not match the network (%d inputs)\n", net.getInputSize());
+        return 1;
+    }
+    printEvaluation("Evaluation", net, ds);
+    return 0;
+}
+
+// --- Gradient Check ---
+
+// Compares the analytic full-batch gradient with central finite differences,
+// then runs a few L-BFGS iterations, which must never increase the loss
+// (the line search only accepts steps with sufficient decrease)
+bool checkGradient(const char *name, NeuralNetwork &net, const Dataset &ds, double tolerance) {
+    std::vector<double> params, gradient, unused;
+    net.getParameters(params);
+    double loss = LbfgsOptimizer::lossAndGradient(net, ds, gradient);
+
+    NeuralNetwork probe = net;
+    std::vector<double> shifted = params;
+    double worst = 0.0;
+    size_t worstIndex = 0;
+    for (size_t i = 0; i < params.size(); i++) {
+        const double h = 1e-5 * std::max(1.0, std::fabs(params[i]));
+        shifted[i] = params[i] + h;
+        probe.setParameters(shifted);
+        double plus = LbfgsOptimizer::lossAndGradient(probe, ds, unused);
+        shifted[i] = params[i] - h;
+        probe.setParameters(shifted);
+        double minus = LbfgsOptimizer::lossAndGradient(probe, ds, unused);
+        shifted[i] = params[i];
+
+        // setParameters() keeps pruned weights at zero, so both sides agree on 0 there
+        double numeric = (plus - minus) / (2.0 * h);
+        double error = std::fabs(numeric - gradient[i]) / std::max(1.0, std::fabs(numeric) + std::fabs(gradient[i]));
+        if (error > worst) {
+            worst = error;
+            worstIndex = i;
+        }
+    }
+
+    LbfgsOptimizer lbfgs;
+    double previous = loss;
+    bool monotonic = true;
+    int iterations = 0;
+    for (; iterations < 25 && !lbfgs.hasConverged(); iterations++) {
+        double next = lbfgs.step(net, ds);
+        if (next > previous) monotonic = false;
+        previous = next;
+    }
+
+    bool ok = worst <= tolerance && monotonic;
+    printf("%-28s %4zu params  loss %10.6f  max error %.2e (param %zu)  L-BFGS %2d steps -> %.6f%s  %s\n",
+           name, params.size(), loss, worst, worstIndex, iterations, previous,
+           monotonic ? "" : " (loss went up)", ok ? "OK" : "FAILED");
+    return ok;
+}
+
+int runCheckGradient(const Options &opt) {
+    double tolerance = opt.getDouble("tolerance", 1e-6);
+    bool ok = true;
+
+    if (opt.has("data")) {
+        std::vector<DataPoint> points;
+        if (!loadPoints(opt, points)) return 1;
+        Dataset ds = buildDataset(opt, points);
+
+        NeuralNetwork net(parseSeed(opt));
+        net.setup(ds.inputSize, opt.getInt("layers", 1), opt.getInt("neurons", 8), ds.outputSize,
+                  parseActivation(opt.get("act", "SIGMOID")), ds.mode, parseInit(opt.get("init", "XAVIER")));
+        std::vector<double> sparsity;
+        if (!NeuralNetwork::parseLayerSparsity(opt.get("prune", ""), net.getLayerCount(), sparsity)) {
+            fprintf(stderr, "--prune needs one sparsity or one per layer (%d), each in [0, 1)\n", net.getLayerCount());
+            return 1;
+        }
+        net.pruneAll(sparsity);
+        ok = checkGradient(opt.get("data", "").c_str(), net, ds, tolerance);
+    } else {
+        // Deterministic points: three interleaved classes on a lattice
+        std::vector<DataPoint> points;
+        for (int i = 0; i < 150; i++) points.push_back({ (i % 13) - 6.0, (i % 7) - 3.0, i % 3 });
+        Dataset classes = Dataset::fromPoints(points, 10.0, TaskMode::CLASSIFICATION, 3);
+        Dataset curve = Dataset::fromPoints(points, 10.0, TaskMode::REGRESSION, 1);
+
+        NeuralNetwork sigmoid(3), tanhNet(3), regression(3), pruned(3);
+        sigmoid.setup(2, 1, 6, 3, ActivationType::SIGMOID, TaskMode::CLASSIFICATION, InitType::XAVIER);
+        tanhNet.setup(2, 2, 5, 3, ActivationType::TANH, TaskMode::CLASSIFICATION, InitType::HE);
+        regression.setup(1, 1, 6, 1, ActivationType::TANH, TaskMode::REGRESSION, InitType::XAVIER);
+        pruned.setup(2, 2, 8, 3, ActivationType::TANH, TaskMode::CLASSIFICATION, InitType::XAVIER);
+        pruned.pruneAll({ 0.5, 0.5, 0.0 });
+
+        ok = checkGradient("classification, sigmoid", sigmoid, classes, tolerance) && ok;
+        ok = checkGradient("classification, tanh, 2 hidden", tanhNet, classes, tolerance) && ok;
+        ok = checkGradient("regression", regression, curve, tolerance) && ok;
+        ok = checkGradient("pruned 50% hidden", pruned, classes, tolerance) && ok;
+    }
+
+    printf("%s\n", ok ? "Gradient check passed" : "Gradient check FAILED");
+    return ok ? 0 : 1;
+}
+
+void printUsage() {
+    printf("Usage: NeuoronLabCli <command> [options]\n\n"
+           "Commands:\n"
+           "  sweep     Train a grid of models in parallel and rank them by final loss\n"
+           "  train     Train a single model (optionally with magnitude pruning)\n"
+           "  evaluate  Score a checkpoint: accuracy, confusion matrix, per-class loss\n"
+           "  check-gradient  Verify the L-BFGS gradient against finite differences\n\n"
+           "Run with a command and --data FILE; see src/cli.cpp for all options.\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    Options opt = parseArgs(argc, argv);
+
+    // Every parallel section (init, sweep) shares this pool; size it before first use
+    ThreadPool::configure(opt.getInt("threads", 0), opt.has("pin"));
+    TuningCache::instance().load(opt.get("tuning-cache", Autotuner::defaultCachePath()));
+
+    // Telemetry for any command; the exporter stops when main returns
+    MetricsExporter exporter;
+    if (opt.has("metrics-port") && !exporter.serveHttp(opt.getInt("metrics-port", 9464))) {
+        fprintf(stderr, "Could not listen on 127.0.0.1:%d\n", opt.getInt("metrics-port", 9464));
+        return 1;
+    }
+    if (opt.has("metrics-file")) exporter.writeTextfile(opt.get("metrics-file", ""));
+
+    if (opt.command == "sweep") return runSweep(opt);
+    if (opt.command == "train") return runTrain(opt);
+    if (opt.command == "evaluate") return runEvaluate(opt);
+    if (opt.command == "check-gradient") return runCheckGradient(opt);
+
+    printUsage();
+    return opt.command.empty() ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#include "dataset.h"
+#include "random.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+void Dataset::buildTarget(size_t i, double targetMin, std::vector<double> &target) const {
+    if (mode == TaskMode::REGRESSION) {
+        target.assign(1, values[i]);
+        return;
+    }
+    // Initialize target vector with min value (e.g., -1 or 0)
+    target.assign(outputSize, targetMin);
+
+    // Set the correct class index to max value (1.0)
+    if (labels[i] >= 0 && labels[i] < outputSize) target[labels[i]] = 1.0;
+}
+
+void Dataset::epochOrder(uint64_t seed, int epoch, std::vector<size_t> &order) const {
+    order.resize(size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+
+    CounterRng rng(seed, RngStream::SHUFFLE + (uint64_t)epoch);
+    rng.shuffle(order);
+}
+
+Dataset Dataset::fromPoints(const std::vector<DataPoint> &points, double range, TaskMode taskMode, int outSize) {
+    Dataset ds;
+    ds.mode = taskMode;
+    ds.inputSize = (taskMode == TaskMode::REGRESSION) ? 1 : 2;
+    ds.outputSize = (taskMode == TaskMode::REGRESSION) ? 1 : outSize;
+    ds.inputs.reserve(points.size());
+
+    for (const auto &p : points) ds.append(p, range);
+    return ds;
+}
+
+void Dataset::append(const DataPoint &p, double range) {
+    if (mode == TaskMode::REGRESSION) {
+        // Regression: Input X -> Target Y
+        inputs.push_back({ p.x / range });
+        values.push_back(p.y / range);
+    } else {
+        // Classification: Input (X,Y) -> Class
+        inputs.push_back({ p.x / range, p.y / range });
+        labels.push_back(p.classID);
+    }
+}
+
+bool Dataset::loadPoints(const std::string &path, std::vector<DataPoint> &points) {
+    std::ifstream in(path);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        // Accept both comma and whitespace separated columns
+        for (char &c : line) {
+            if (c == ',' || c == ';' || c == '\t') c = ' ';
+        }
+        std::istringstream ss(line);
+        DataPoint p{0.0, 0.0, 0};
+        if (!(ss >> p.x >> p.y)) continue; // Skip headers and malformed rows
+        ss >> p.classID;
+        points.push_back(p);
+    }
+    return true;
+}
+
+namespace {
+
+// IDX headers are big-endian 32-bit integers
+bool readBigEndian(std::istream &in, uint32_t &value) {
+    unsigned char b[4];
+    if (!in.read(reinterpret_cast<char*>(b), 4)) return false;
+    value = (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 8) | uint32_t(b[3]);
+    return true;
+}
+
+// Bytes from the current position to the end of the file
+uint64_t bytesLeft(std::ifstream &in) {
+    std::streampos pos = in.tellg();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(pos);
+    return (pos < 0 || end < pos) ? 0 : (uint64_t)(end - pos);
+}
+
+} // namespace
+
+bool Dataset::loadIdx(const std::string &imagesPath, const std::string &labelsPath, Dataset &out) {
+    std::ifstream images(imagesPath, std::ios::binary);
+    std::ifstream labelFile(labelsPath, std::ios::binary);
+    if (!images || !labelFile) return false;
+
+    uint32_t imageMagic, imageCount, rows, cols, labelMagic, labelCount;
+    if (!readBigEndian(images, imageMagic) || imageMagic != 0x00000803) return false;
+    if (!readBigEndian(images, imageCount) || !readBigEndian(images, rows) || !readBigEndian(images, cols)) return false;
+    if (!readBigEndian(labelFile, labelMagic) || labelMagic != 0x00000801) return false;
+    if (!readBigEndian(labelFile, labelCount) || labelCount != imageCount) return false;
+
+    // The header is untrusted: both files must really hold that many samples
+    // before anything is sized from it
+    uint64_t imageBytes = (uint64_t)rows * cols;
+    if (imageBytes == 0 || imageBytes > (uint64_t)INT32_MAX) return false;
+    if (imageBytes * imageCount > bytesLeft(images) || labelCount > bytesLeft(labelFile)) return false;
+
+    Dataset ds;
+    ds.mode = TaskMode::CLASSIFICATION;
+    ds.inputSize = (int)(rows * cols);
+    ds.inputs.resize(imageCount);
+    ds.labels.resize(imageCount);
+
+    std::vector<unsigned char> pixels(ds.inputSize);
+    for (uint32_t i = 0; i < imageCount; i++) {
+        unsigned char label;
+        if (!images.read(reinterpret_cast<char*>(pixels.data()), pixels.size())) return false;
+        if (!labelFile.read(reinterpret_cast<char*>(&label), 1)) return false;
+
+        ds.inputs[i].resize(ds.inputSize);
+        for (int p = 0; p < ds.inputSize; p++) ds.inputs[i][p] = pixels[p] / 255.0;
+        ds.labels[i] = label;
+        ds.outputSize = std::max(ds.outputSize, (int)label + 1);
+    }
+
+    out = std::move(ds);
+    return true;
+}
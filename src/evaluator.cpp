@@ -0,0 +1,143 @@
+#include "evaluator.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+EvaluationResult Evaluator::evaluate(const NeuralNetwork &network, const Dataset &data, TaskPriority priority) {
+    auto start = std::chrono::steady_clock::now();
+
+    EvaluationResult result;
+    result.mode = data.mode;
+    result.samples = data.size();
+    if (data.empty() || network.getLayerCount() == 0 || data.inputSize != network.getInputSize()) return result;
+    result.classes = (data.mode == TaskMode::CLASSIFICATION) ? network.getOutputSize() : 0;
+
+    const int classes = result.classes;
+    const int inputSize = network.getInputSize();
+    const int outputSize = network.getOutputSize();
+    const double targetMin = Dataset::targetMinFor(network.getActivation());
+
+    // Batch size and thread count come from the (auto-tuned) kernel config
+    const KernelConfig &kernel = network.getKernelConfig();
+    const size_t batchSize = std::max(1, kernel.batchSize);
+    size_t batchCount = (data.size() + batchSize - 1) / batchSize;
+
+    // Per-sample results, reduced in sample order afterwards so the totals
+    // do not depend on batch size or thread count
+    std::vector<double> sampleLoss(data.size());
+    std::vector<int> predictedClass(data.size(), 0);
+
+    // A grain of batchCount / threads caps how many chunks run at once
+    size_t grain = kernel.threads > 0 ? (batchCount + kernel.threads - 1) / kernel.threads : 1;
+
+    parallelFor(0, batchCount, grain, [&](size_t batchBegin, size_t batchEnd) {
+        std::vector<double> batchInputs, outputs, scratch;
+
+        for (size_t batch = batchBegin; batch < batchEnd; batch++) {
+            size_t first = batch * batchSize;
+            size_t count = std::min(batchSize, data.size() - first);
+
+            // Gather the batch into one contiguous block
+            batchInputs.resize(count * inputSize);
+            for (size_t b = 0; b < count; b++) {
+                std::copy(data.inputs[first + b].begin(), data.inputs[first + b].begin() + inputSize,
+                          batchInputs.begin() + b * inputSize);
+            }
+            network.inferBatch(batchInputs.data(), count, outputs, scratch);
+
+            for (size_t b = 0; b < count; b++) {
+                size_t s = first + b;
+                const double *out = &outputs[b * outputSize];
+
+                if (data.mode != TaskMode::CLASSIFICATION) {
+                    double error = data.values[s] - out[0];
+                    sampleLoss[s] = 0.5 * (error * error);
+                    continue;
+                }
+
+                // One-hot target sized by the network (a test set may not contain every class)
+                double loss = 0.0;
+                for (int n = 0; n < outputSize; n++) {
+                    double error = (n == data.labels[s] ? 1.0 : targetMin) - out[n];
+                    loss += 0.5 * (error * error);
+                }
+                sampleLoss[s] = loss;
+
+                // Winner-takes-all, same rule as the heatmap
+                predictedClass[s] = (int)(std::max_element(out, out + outputSize) - out);
+            }
+        }
+    }, priority);
+
+    // --- Reduce ---
+    result.confusion.assign((size_t)classes * classes, 0);
+    result.classLoss.assign(classes, 0.0);
+    result.classCount.assign(classes, 0);
+    double lossSum = 0.0;
+
+    for (size_t s = 0; s < data.size(); s++) {
+        lossSum += sampleLoss[s];
+        if (data.mode != TaskMode::CLASSIFICATION) continue;
+
+        int actual = data.labels[s];
+        if (actual == predictedClass[s]) result.correct++;
+        if (actual >= 0 && actual < classes) {
+            result.confusion[actual * classes + predictedClass[s]]++;
+            result.classLoss[actual] += sampleLoss[s];
+            result.classCount[actual]++;
+        }
+    }
+    for (int c = 0; c < classes; c++) {
+        if (result.classCount[c] > 0) result.classLoss[c] /= result.classCount[c];
+    }
+
+    result.meanLoss = lossSum / data.size();
+    result.accuracy = (double)result.correct / data.size();
+    result.wallTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+std::string EvaluationResult::format() const {
+    std::string out;
+    char line[160];
+
+    if (mode == TaskMode::REGRESSION) {
+        snprintf(line, sizeof(line), "Samples: %zu   Mean loss: %.6f   Time: %.2f ms\n",
+                 samples, meanLoss, wallTimeMs);
+        return line;
+    }
+
+    snprintf(line, sizeof(line), "Samples: %zu   Accuracy: %.2f%% (%zu/%zu)   Mean loss: %.6f   Time: %.2f ms\n\n",
+             samples, accuracy * 100.0, correct, samples, meanLoss, wallTimeMs);
+    out += line;
+
+    // --- Per-Class Table ---
+    snprintf(line, sizeof(line), "%-6s %-8s %-12s %-8s\n", "Class", "Count", "Loss", "Recall");
+    out += line;
+    for (int c = 0; c < classes; c++) {
+        double recall = classCount[c] ? 100.0 * confusionAt(c, c) / classCount[c] : 0.0;
+        snprintf(line, sizeof(line), "%-6d %-8zu %-12.6f %.1f%%\n", c, classCount[c], classLoss[c], recall);
+        out += line;
+    }
+
+    // --- Confusion Matrix ---
+    out += "\nConfusion matrix (rows = true class, columns = predicted):\n";
+    snprintf(line, sizeof(line), "%6s", "");
+    out += line;
+    for (int p = 0; p < classes; p++) {
+        snprintf(line, sizeof(line), " %6s", ("P" + std::to_string(p)).c_str());
+        out += line;
+    }
+    out += "\n";
+    for (int a = 0; a < classes; a++) {
+        snprintf(line, sizeof(line), "%-6s", ("T" + std::to_string(a)).c_str());
+        out += line;
+        for (int p = 0; p < classes; p++) {
+            snprintf(line, sizeof(line), " %6zu", confusionAt(a, p));
+            out += line;
+        }
+        out += "\n";
+    }
+    return out;
+}
@@ -0,0 +1,69 @@
+#include "importancesampler.h"
+#include "random.h"
+#include <algorithm>
+#include <cmath>
+
+ImportanceSampler::ImportanceSampler(const ImportanceConfig &samplerConfig)
+    : config(samplerConfig), lastSampleCount(0), lastWasFullSweep(false)
+{
+}
+
+double ImportanceSampler::trainEpoch(NeuralNetwork &network, const Dataset &data, double learningRate, uint64_t seed, int epoch) {
+    size_t n = data.size();
+    if (n == 0) return 0.0;
+    double targetMin = Dataset::targetMinFor(network.getActivation());
+
+    // New points (or a new data set) have no estimate yet: sweep everything once
+    if (losses.size() != n) losses.assign(n, -1.0);
+    bool unknown = std::find_if(losses.begin(), losses.end(), [](double l) { return l < 0.0; }) != losses.end();
+    bool fullSweep = unknown || config.fullSweepInterval <= 1 || epoch % config.fullSweepInterval == 0;
+
+    lastWasFullSweep = fullSweep;
+
+    // --- 1. Full Sweep (plain shuffled SGD) ---
+    if (fullSweep) {
+        data.epochOrder(seed, epoch, order);
+        double epochError = 0.0;
+        for (size_t i : order) {
+            data.buildTarget(i, targetMin, target);
+            losses[i] = network.train(data.inputs[i], target, learningRate);
+            epochError += losses[i];
+        }
+        lastSampleCount = n;
+        return epochError;
+    }
+
+    // --- 2. Sampling Distribution ---
+    // p_i = (1 - a) * loss_i / sum + a / N
+    double total = 0.0;
+    for (double l : losses) total += l;
+    double mix = (total > 0.0) ? std::min(1.0, std::max(0.0, config.uniformMix)) : 1.0;
+
+    cumulative.resize(n);
+    double running = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double p = (1.0 - mix) * (total > 0.0 ? losses[i] / total : 0.0) + mix / n;
+        running += p;
+        cumulative[i] = running;
+    }
+
+    // --- 3. Weighted Draws ---
+    size_t draws = std::max<size_t>(1, (size_t)std::llround(config.sampleFraction * n));
+    for (size_t d = 0; d < draws; d++) {
+        double u = CounterRng::uniformAt(seed, RngStream::IMPORTANCE + (uint64_t)epoch, d) * running;
+        size_t i = std::upper_bound(cumulative.begin(), cumulative.end(), u) - cumulative.begin();
+        if (i >= n) i = n - 1;
+
+        double p = cumulative[i] - (i > 0 ? cumulative[i-1] : 0.0);
+        double weight = running / (n * p); // 1 / (N * p_i), p normalized by 'running'
+
+        data.buildTarget(i, targetMin, target);
+        losses[i] = network.train(data.inputs[i], target, learningRate * weight);
+    }
+    lastSampleCount = draws;
+
+    // Same scale as a full sweep; unvisited samples contribute their last estimate
+    double epochError = 0.0;
+    for (double l : losses) epochError += l;
+    return epochError;
+}
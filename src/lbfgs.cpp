@@ -0,0 +1,286 @@
+#include "lbfgs.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+double dot(const std::vector<double> &a, const std::vector<double> &b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); i++) sum += a[i] * b[i];
+    return sum;
+}
+
+} // namespace
+
+LbfgsOptimizer::LbfgsOptimizer(const LbfgsConfig &optimizerConfig)
+    : config(optimizerConfig), loss(0.0), converged(false), lastEvaluations(0)
+{
+}
+
+void LbfgsOptimizer::reset() {
+    sHistory.clear();
+    yHistory.clear();
+    params.clear();
+    gradient.clear();
+    converged = false;
+}
+
+void LbfgsOptimizer::getHistory(std::vector<std::vector<double>> &s, std::vector<std::vector<double>> &y) const {
+    s.assign(sHistory.begin(), sHistory.end());
+    y.assign(yHistory.begin(), yHistory.end());
+}
+
+void LbfgsOptimizer::setHistory(const std::vector<std::vector<double>> &s, const std::vector<std::vector<double>> &y) {
+    reset();
+    if (s.size() != y.size()) return;
+    sHistory.assign(s.begin(), s.end());
+    yHistory.assign(y.begin(), y.end());
+}
+
+double LbfgsOptimizer::lossAndGradient(const NeuralNetwork &network, const Dataset &data, std::vector<double> &gradient) {
+    const size_t paramCount = network.getParameterCount();
+    gradient.assign(paramCount, 0.0);
+    if (data.empty() || network.getLayerCount() == 0 || data.inputSize != network.getInputSize()) return 0.0;
+
+    const int inputSize = network.getInputSize();
+    const int outputSize = network.getOutputSize();
+    const double targetMin = Dataset::targetMinFor(network.getActivation());
+
+    // Fixed chunking keeps the summation order (and the result) independent of the thread count:
+    // 64-sample batches, grouped into at most 32 partial sums reduced in order afterwards
+    const size_t CHUNK = 64;
+    size_t chunkCount = (data.size() + CHUNK - 1) / CHUNK;
+    size_t groupCount = std::min<size_t>(chunkCount, 32);
+    size_t chunksPerGroup = (chunkCount + groupCount - 1) / groupCount;
+    groupCount = (chunkCount + chunksPerGroup - 1) / chunksPerGroup;
+
+    std::vector<std::vector<double>> groupGradient(groupCount);
+    std::vector<double> groupLoss(groupCount, 0.0);
+
+    parallelFor(0, groupCount, 1, [&](size_t groupBegin, size_t groupEnd) {
+        std::vector<double> batchInputs, batchTargets, target, scratch;
+
+        for (size_t group = groupBegin; group < groupEnd; group++) {
+            std::vector<double> &partial = groupGradient[group];
+            partial.assign(paramCount, 0.0);
+
+            size_t lastChunk = std::min(chunkCount, (group + 1) * chunksPerGroup);
+            for (size_t chunk = group * chunksPerGroup; chunk < lastChunk; chunk++) {
+                size_t first = chunk * CHUNK;
+                size_t count = std::min(CHUNK, data.size() - first);
+
+                // Gather the chunk into contiguous input and target blocks
+                batchInputs.resize(count * inputSize);
+                batchTargets.resize(count * outputSize);
+                for (size_t b = 0; b < count; b++) {
+                    std::copy(data.inputs[first + b].begin(), data.inputs[first + b].begin() + inputSize,
+                              batchInputs.begin() + b * inputSize);
+                    data.buildTarget(first + b, targetMin, target);
+                    for (int n = 0; n < outputSize; n++) {
+                        batchTargets[b * outputSize + n] = n < (int)target.size() ? target[n] : targetMin;
+                    }
+                }
+                groupLoss[group] += network.lossGradientBatch(batchInputs.data(), batchTargets.data(), count,
+                                                              partial, scratch);
+            }
+        }
+    });
+
+    // --- Reduce (group order) ---
+    double total = 0.0;
+    for (size_t group = 0; group < groupCount; group++) {
+        total += groupLoss[group];
+        for (size_t i = 0; i < paramCount; i++) gradient[i] += groupGradient[group][i];
+    }
+    return total;
+}
+
+double LbfgsOptimizer::evaluateAt(NeuralNetwork &network, const Dataset &data, double stepLength, LinePoint &point) {
+    trialParams.resize(params.size());
+    for (size_t i = 0; i < params.size(); i++) trialParams[i] = params[i] + stepLength * direction[i];
+    network.setParameters(trialParams);
+
+    point.step = stepLength;
+    point.loss = lossAndGradient(network, data, trialGradient);
+    point.slope = dot(trialGradient, direction);
+    lastEvaluations++;
+    return point.loss;
+}
+
+void LbfgsOptimizer::searchDirection() {
+    // Two-loop recursion: direction = -H * gradient, H the L-BFGS inverse-Hessian estimate
+    size_t m = sHistory.size();
+    std::vector<double> alpha(m), rho(m);
+    direction = gradient;
+
+    for (size_t k = m; k-- > 0;) {
+        rho[k] = 1.0 / dot(yHistory[k], sHistory[k]);
+        alpha[k] = rho[k] * dot(sHistory[k], direction);
+        for (size_t i = 0; i < direction.size(); i++) direction[i] -= alpha[k] * yHistory[k][i];
+    }
+
+    // Initial Hessian scaled by the newest pair (s.y / y.y)
+    if (m > 0) {
+        double gamma = dot(sHistory.back(), yHistory.back()) / dot(yHistory.back(), yHistory.back());
+        for (double &d : direction) d *= gamma;
+    }
+
+    for (size_t k = 0; k < m; k++) {
+        double beta = rho[k] * dot(yHistory[k], direction);
+        for (size_t i = 0; i < direction.size(); i++) direction[i] += sHistory[k][i] * (alpha[k] - beta);
+    }
+
+    for (double &d : direction) d = -d;
+}
+
+double LbfgsOptimizer::step(NeuralNetwork &network, const Dataset &data) {
+    lastEvaluations = 0;
+    if (network.getLayerCount() == 0 || data.empty()) return 0.0;
+
+    // --- 1. Current Point ---
+    // Loss and gradient carry over from the previous step unless the parameters
+    // were changed outside the optimizer (pruning, a new network, a resumed run)
+    std::vector<double> current;
+    network.getParameters(current);
+    if (current != params || gradient.size() != current.size()) {
+        // History from another topology is useless
+        if (!sHistory.empty() && sHistory.front().size() != current.size()) {
+            sHistory.clear();
+            yHistory.clear();
+        }
+        params = current;
+        loss = lossAndGradient(network, data, gradient);
+        converged = false;
+        lastEvaluations++;
+    }
+    if (converged) return loss;
+
+    double gradientMax = 0.0;
+    for (double g : gradient) gradientMax = std::max(gradientMax, std::fabs(g));
+    if (gradientMax < config.gradientTolerance) {
+        converged = true;
+        return loss;
+    }
+
+    // --- 2. Search Direction ---
+    searchDirection();
+    double slope0 = dot(gradient, direction);
+    if (!(slope0 < 0.0)) {
+        // Not a descent direction (stale curvature): fall back to steepest descent
+        sHistory.clear();
+        yHistory.clear();
+        direction = gradient;
+        for (double &d : direction) d = -d;
+        slope0 = dot(gradient, direction);
+    }
+
+    // --- 3. Strong Wolfe Line Search ---
+    // Without curvature information the first trial moves one unit in parameter space
+    double firstStep = sHistory.empty() ? std::min(1.0, 1.0 / std::sqrt(-slope0)) : 1.0;
+    const double c1 = config.sufficientDecrease;
+    const double c2 = config.curvature;
+    auto armijo = [&](const LinePoint &p) { return p.loss <= loss + c1 * p.step * slope0; };
+    auto curvatureOk = [&](const LinePoint &p) { return std::fabs(p.slope) <= -c2 * slope0; };
+
+    LinePoint origin;
+    origin.loss = loss;
+    origin.slope = slope0;
+
+    LinePoint lo = origin, hi, trial;
+    int budget = lastEvaluations + std::max(1, config.maxLineSearchSteps);
+    bool accepted = false;
+    bool bracketed = false;
+    double stepLength = firstStep;
+
+    while (lastEvaluations < budget) {
+        evaluateAt(network, data, stepLength, trial);
+        if (!armijo(trial) || (lo.step > 0.0 && trial.loss >= lo.loss) || !std::isfinite(trial.loss)) {
+            hi = trial;
+            bracketed = true;
+            break;
+        }
+        if (curvatureOk(trial)) {
+            accepted = true;
+            break;
+        }
+        if (trial.slope >= 0.0) {
+            hi = lo;
+            lo = trial;
+            bracketed = true;
+            break;
+        }
+        lo = trial;
+        stepLength *= 2.0;
+    }
+
+    // Zoom: shrink [lo, hi] until a point satisfies both Wolfe conditions
+    while (bracketed && !accepted && lastEvaluations < budget) {
+        double a = lo.step, b = hi.step;
+        double next;
+
+        // Cubic interpolation through both ends, bisection if it lands too close to either
+        double d1 = lo.slope + hi.slope - 3.0 * (lo.loss - hi.loss) / (a - b);
+        double radicand = d1 * d1 - lo.slope * hi.slope;
+        if (radicand >= 0.0 && std::isfinite(hi.loss)) {
+            double d2 = (b > a ? 1.0 : -1.0) * std::sqrt(radicand);
+            next = b - (b - a) * (hi.slope + d2 - d1) / (hi.slope - lo.slope + 2.0 * d2);
+        } else {
+            next = 0.5 * (a + b);
+        }
+        double low = std::min(a, b), width = std::fabs(b - a);
+        if (!std::isfinite(next) || next < low + 0.1 * width || next > low + 0.9 * width) next = 0.5 * (a + b);
+
+        evaluateAt(network, data, next, trial);
+        if (!armijo(trial) || trial.loss >= lo.loss || !std::isfinite(trial.loss)) {
+            hi = trial;
+        } else {
+            if (curvatureOk(trial)) {
+                accepted = true;
+                break;
+            }
+            if (trial.slope * (hi.step - lo.step) >= 0.0) hi = lo;
+            lo = trial;
+        }
+    }
+
+    // Out of evaluations: settle for the best decreasing point seen so far
+    if (!accepted && lo.step > 0.0) {
+        evaluateAt(network, data, lo.step, trial);
+        accepted = true;
+    }
+
+    if (!accepted) {
+        network.setParameters(params);
+        if (sHistory.empty()) {
+            converged = true; // Not even steepest descent makes progress
+        } else {
+            sHistory.clear();
+            yHistory.clear();
+        }
+        return loss;
+    }
+
+    // --- 4. Update (the network already holds the trial parameters) ---
+    std::vector<double> s(params.size()), y(params.size());
+    for (size_t i = 0; i < params.size(); i++) {
+        s[i] = trialParams[i] - params[i];
+        y[i] = trialGradient[i] - gradient[i];
+    }
+
+    // Only pairs with positive curvature keep the estimate positive definite
+    double sy = dot(s, y);
+    if (sy > 1e-10 * std::sqrt(dot(s, s) * dot(y, y))) {
+        sHistory.push_back(std::move(s));
+        yHistory.push_back(std::move(y));
+        while ((int)sHistory.size() > std::max(1, config.historySize)) {
+            sHistory.pop_front();
+            yHistory.pop_front();
+        }
+    }
+
+    network.getParameters(params); // Masked entries as the network stores them
+    gradient.swap(trialGradient);
+    loss = trial.loss;
+    return loss;
+}
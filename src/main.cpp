@@ -1,10 +1,27 @@
 #include "mainwindow.h"
+#include "metrics.h"
+#include "threadpool.h"
+#include "autotuner.h"
 
 #include <QApplication>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    // Shared thread pool for training, sweeps and the heatmap (default: all cores)
+    ThreadPool::configure(qgetenv("NEURONLAB_THREADS").toInt(), !qgetenv("NEURONLAB_PIN_THREADS").isEmpty());
+
+    // Kernel configs tuned on earlier runs (shared with the CLI)
+    TuningCache::instance().load(Autotuner::defaultCachePath());
+
+    // Optional OpenMetrics telemetry (same exporter as the headless CLI)
+    MetricsExporter exporter;
+    QByteArray metricsPort = qgetenv("NEURONLAB_METRICS_PORT");
+    QByteArray metricsFile = qgetenv("NEURONLAB_METRICS_FILE");
+    if (!metricsPort.isEmpty()) exporter.serveHttp(metricsPort.toInt());
+    if (!metricsFile.isEmpty()) exporter.writeTextfile(metricsFile.toStdString());
+
     MainWindow w;
     w.show();
     return a.exec();
@@ -1,25 +1,53 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
+#include "sweepdialog.h"
+#include "autotuner.h"
+#include "metrics.h"
 #include <QApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QStandardPaths>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , network(nullptr)
+    , checkpointWriter(nullptr)
+    , runSeed(NeuralNetwork::DEFAULT_SEED)
+    , onlineDataValid(false)
+    , onlineTimer(nullptr)
+    , tuningThread(nullptr)
     , isTraining(false)
     , hasTrained(false)
+    , runEpoch(0)
 {
     ui->setupUi(this);
 
     // Initialize RenderArea
     ui->renderArea->setNetwork(nullptr);
+    ui->renderArea->setIngestQueue(&online.getQueue());
+
+    // Online trainer runs on the UI thread between events (Tools > Online Training)
+    onlineTimer = new QTimer(this);
+    onlineTimer->setInterval(ONLINE_TICK_MS);
+    connect(onlineTimer, &QTimer::timeout, this, &MainWindow::onlineTick);
 
     // Sync UI with the default selection defined in Designer
     updateUIForMode();
 }
 
 MainWindow::~MainWindow() {
-    // Memory Cleanup
+    // A running benchmark only touches its own network copy and the tuning cache
+    if(tuningThread) {
+        tuningThread->wait();
+        delete tuningThread;
+    }
+
+    // Memory Cleanup (the writer flushes its last snapshot before joining)
+    if(checkpointWriter) delete checkpointWriter;
     if(network) delete network;
     delete ui;
 }
@@ -60,6 +88,7 @@ void MainWindow::updateUIForMode() {
 void MainWindow::on_cmbMode_currentIndexChanged(int index) {
     Q_UNUSED(index);
     updateUIForMode();
+    resetOnline();
 }
 
 void MainWindow::on_spinCurrentClass_valueChanged(int arg1) {
@@ -67,6 +96,11 @@ void MainWindow::on_spinCurrentClass_valueChanged(int arg1) {
     ui->renderArea->setCurrentClass(arg1);
 }
 
+void MainWindow::on_cmbOptimizer_currentIndexChanged(int index) {
+    // L-BFGS picks its own step lengths
+    ui->spinLR->setEnabled(index == (int)OptimizerType::SGD);
+}
+
 void MainWindow::on_btnCreate_clicked() {
     // 1. Garbage Collection: Delete existing network
 
@@ -77,8 +111,9 @@ void MainWindow::on_btnCreate_clicked() {
          network = nullptr;
     }
 
-    // 2. Instantiate New Network
-    network = new NeuralNetwork();
+    // 2. Instantiate New Network (seeded: same settings give the same weights)
+    runSeed = ui->spinSeed->value();
+    network = new NeuralNetwork(runSeed);
     ui->renderArea->setNetwork(network);
 
     // Parse UI Configuration
@@ -110,15 +145,25 @@ void MainWindow::on_btnCreate_clicked() {
         act = (userChoice == "TANH") ? ActivationType::TANH : ActivationType::SIGMOID;
     }
 
+    QString initChoice = ui->cmbInit->currentText();
+    InitType init = (initChoice == "HE") ? InitType::HE
+                  : (initChoice == "UNIFORM") ? InitType::UNIFORM : InitType::XAVIER;
+
     // Initialize Network Architecture
-    network->setup(inputSize, hiddenLayers, neuronsPerLayer, outputSize, act, task);
+    network->setup(inputSize, hiddenLayers, neuronsPerLayer, outputSize, act, task, init);
+    applyKernelTuning();
+    sampler.reset();
+    lbfgs.reset();
+    resetOnline();
 
     // Update UI State
     hasTrained = false;
+    runEpoch = 0;
     ui->btnTrain->setText("Start Training");
     ui->btnTrain->setEnabled(true);
     ui->btnTest->setEnabled(false);
     ui->lblError->setText("Network Created. Ready.");
+    ui->lblAccuracy->setText("Accuracy: -");
 }
 
 void MainWindow::on_btnReset_clicked() {
@@ -138,13 +183,18 @@ void MainWindow::on_btnReset_clicked() {
     ui->renderArea->clearData();
     ui->renderArea->setVisualizeMode(false);
     ui->renderArea->setShowLines(false);
+    sampler.reset();
+    lbfgs.reset();
+    resetOnline();
 
     // 3. Reset UI Controls
     ui->lblError->setText("Network Deleted. Create new one.");
     ui->lblEpoch->setText("Epoch: 0");
+    ui->lblAccuracy->setText("Accuracy: -");
     ui->btnTrain->setEnabled(false);
     ui->btnTest->setEnabled(false);
     hasTrained = false;
+    runEpoch = 0;
     ui->btnTrain->setText("Start Training");
 }
 
@@ -160,14 +210,19 @@ void MainWindow::on_btnTrain_clicked() {
     }
 
     // Data Validation
-    auto data = ui->renderArea->getData();
-    double range = ui->renderArea->getAxisRange();
+    Dataset data = buildDataset();
 
     if(data.empty()) {
         ui->lblError->setText("No data points!");
         return;
     }
 
+    // Per-layer pruning targets (one value: hidden layers only)
+    if(!NeuralNetwork::parseLayerSparsity(ui->editSparsity->text().toStdString(), network->getLayerCount(), pruneSparsity)) {
+        ui->lblError->setText(QString("Sparsity: one value or %1 (one per layer)").arg(network->getLayerCount()));
+        return;
+    }
+
     // Start Training Loop
     isTraining = true;
     ui->btnTrain->setText("Stop Training");
@@ -182,41 +237,78 @@ void MainWindow::on_btnTrain_clicked() {
 
     int maxEpochs = ui->spinMaxEpochs->value();
     double lr = ui->spinLR->value();
-    int outputSize = ui->spinOutputLayer->value();
+    const std::vector<double> sparsity = pruneSparsity;
+    uint64_t seed = runSeed;
+
+    bool useLbfgs = (ui->cmbOptimizer->currentIndex() == (int)OptimizerType::LBFGS);
+    bool importance = ui->actionImportance->isChecked();
+    bool converged = false;
+    size_t samplesTrained = 0;
+    size_t samplesPlain = 0;
 
     int drawInterval = 1; // Update UI every epoch
 
     // Target Value Setup (Tanh: -1..1, Sigmoid: 0..1)
     QString actText = ui->cmbActivation->currentText();
     double targetMin = (actText == "TANH") ? -1.0 : 0.0;
-    double targetMax = 1.0;
+    std::vector<double> target;
+    std::vector<size_t> order;
 
-    // --- MAIN TRAINING LOOP ---
-    for(int epoch = 0; epoch < maxEpochs && isTraining; epoch++) {
-        double epochError = 0;
+    // Points clicked from here on arrive through the ingestion queue
+    online.discardPending();
+    online.reset();
+    double range = ui->renderArea->getAxisRange();
 
-        for(const auto &p : data) {
-            std::vector<double> input;
-            std::vector<double> target;
+    // A paused run continues where it stopped, a finished one starts over
+    if(runEpoch >= maxEpochs) runEpoch = 0;
+    if(useLbfgs && (runEpoch == 0 || lbfgs.hasConverged())) {
+        runEpoch = 0;
+        lbfgs.reset();
+    }
+    QElapsedTimer checkpointTimer;
+    checkpointTimer.start();
 
-            if(isRegression) {
-                // Regression: Input X -> Target Y
-                input.push_back(p.x / range);
-                target.push_back(p.y / range);
-            } else {
-                // Classification: Input (X,Y) -> One-Hot Target
-                input = { p.x / range, p.y / range };
+    // --- MAIN TRAINING LOOP ---
+    for(; runEpoch < maxEpochs && isTraining; runEpoch++) {
+        int epoch = runEpoch;
+        double epochError = 0;
 
-                // Initialize target vector with min value (e.g., -1 or 0)
-                target.resize(outputSize, targetMin);
+        // Points clicked during training join the next epoch without rebuilding the data set
+        if(online.drain(data, range) > 0 && useLbfgs) {
+            lbfgs.reset(); // New points change the objective; restart the curvature history
+        }
 
-                // Set the correct class index to max value (1.0)
-                if(p.classID < outputSize) target[p.classID] = targetMax;
+        // Iterative magnitude pruning (no-op when sparsity is 0)
+        network->applyPruneSchedule(sparsity, epoch, maxEpochs);
+
+        QElapsedTimer epochTimer;
+        epochTimer.start();
+        size_t epochSamples = data.size();
+
+        if(useLbfgs) {
+            // One quasi-Newton iteration on the exact full-batch loss and gradient
+            epochError = lbfgs.step(*network, data);
+            epochSamples = data.size() * lbfgs.getLastEvaluations();
+            converged = lbfgs.hasConverged();
+        } else if(importance) {
+            // Hard examples first; new points get a full sweep before they are sampled
+            epochError = sampler.trainEpoch(*network, data, lr, seed, epoch);
+            epochSamples = sampler.getLastSampleCount();
+        } else {
+            // Reproducible per-epoch shuffle, a function of (seed, epoch) only
+            data.epochOrder(seed, epoch, order);
+
+            for(size_t i : order) {
+                // Regression: X -> Y, Classification: (X,Y) -> One-Hot Target
+                data.buildTarget(i, targetMin, target);
+
+                // Train on single sample (Stochastic Gradient Descent)
+                epochError += network->train(data.inputs[i], target, lr);
             }
-
-            // Train on single sample (Stochastic Gradient Descent)
-            epochError += network->train(input, target, lr);
         }
+        samplesTrained += epochSamples;
+        samplesPlain += data.size();
+        CoreMetrics::get().recordEpoch(epochSamples, epochTimer.nsecsElapsed() * 1e-9, epochError);
 
         // UI Updates (Real-time)
         if(epoch % drawInterval == 0) {
@@ -226,6 +318,17 @@ void MainWindow::on_btnTrain_clicked() {
             ui->renderArea->update();
             QApplication::processEvents(); // Keep UI responsive
         }
+
+        // Periodic snapshot; serialization and disk I/O run on the writer thread
+        if(network && checkpointTimer.elapsed() >= CHECKPOINT_INTERVAL_MS) {
+            submitCheckpoint(epoch + 1);
+            checkpointTimer.restart();
+        }
+
+        if(converged) {
+            runEpoch++;
+            break;
+        }
     }
 
     // Training Finished or Paused
@@ -233,16 +336,329 @@ void MainWindow::on_btnTrain_clicked() {
     hasTrained = true;
     ui->btnTrain->setText("Resume Training");
 
+    // Network may have been deleted (Reset) while events were processed
+    if(!network) return;
+    submitCheckpoint(runEpoch);
+
+    if (converged) {
+        ui->statusbar->showMessage(QString("L-BFGS converged after %1 iterations").arg(runEpoch), 5000);
+    } else if (importance && !useLbfgs && samplesPlain > 0) {
+        ui->statusbar->showMessage(QString("Importance sampling: %1 samples trained (%2% of plain SGD)")
+                                   .arg(samplesTrained)
+                                   .arg(100.0 * samplesTrained / samplesPlain, 0, 'f', 1), 5000);
+    }
+
+    // Pick dense or CSR kernels for inference (heatmap) per layer
+    if (std::any_of(sparsity.begin(), sparsity.end(), [](double s) { return s > 0.0; })) {
+        network->selectKernels();
+
+        QStringList layerInfo;
+        for(int i = 0; i < network->getLayerCount(); i++) {
+            layerInfo << QString("L%1 %2% %3").arg(i)
+                                             .arg(network->getSparsity(i) * 100.0, 0, 'f', 0)
+                                             .arg(network->isLayerSparse(i) ? "CSR" : "dense");
+        }
+        ui->statusbar->showMessage("Pruned: " + layerInfo.join(", "));
+    }
+
     // Enable Test button only for Classification
     if (isRegression) {
         ui->btnTest->setEnabled(false);
     } else {
         ui->btnTest->setEnabled(true);
     }
+
+    // Online mode continues from the data set the run ended with. Points drained
+    // during the run have been fit by every epoch since, so none of them is fresh.
+    onlineData = std::move(data);
+    onlineDataValid = true;
+    online.reset();
+}
+
+QString MainWindow::checkpointPath() {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dir);
+    return dir + "/autosave.nlck";
+}
+
+void MainWindow::submitCheckpoint(int completedEpochs) {
+    if(!checkpointWriter) checkpointWriter = new CheckpointWriter(checkpointPath().toStdString());
+
+    // Copy the current state; the writer owns the copy from here on
+    std::unique_ptr<TrainingState> state(new TrainingState);
+    state->network = *network;
+    state->epoch = completedEpochs;
+    state->maxEpochs = ui->spinMaxEpochs->value();
+    state->learningRate = ui->spinLR->value();
+    state->pruneSparsity = pruneSparsity;
+    state->seed = runSeed;
+    state->axisRange = ui->renderArea->getAxisRange();
+    state->points = ui->renderArea->getData();
+    state->errorHistory = ui->widgetErrorGraph->getErrors();
+    state->importanceSampling = ui->actionImportance->isChecked();
+    state->importanceFraction = sampler.getConfig().sampleFraction;
+    state->fullSweepInterval = sampler.getConfig().fullSweepInterval;
+    state->sampleLosses = sampler.getLosses();
+    state->optimizer = (OptimizerType)ui->cmbOptimizer->currentIndex();
+    lbfgs.getHistory(state->lbfgsS, state->lbfgsY);
+
+    checkpointWriter->submit(std::move(state));
+}
+
+void MainWindow::on_actionResume_triggered() {
+    if(isTraining) return;
+
+    QString path = QFileDialog::getOpenFileName(this, "Resume from Checkpoint", checkpointPath(),
+                                                "Checkpoints (*.nlck);;All Files (*)");
+    if(path.isEmpty()) return;
+
+    TrainingState state;
+    if(!Checkpoint::load(path.toStdString(), state)) {
+        ui->lblError->setText("Could not read checkpoint.");
+        return;
+    }
+
+    // 1. Restore Configuration Widgets
+    const NeuralNetwork &net = state.network;
+    bool isRegression = (net.getMode() == TaskMode::REGRESSION);
+    int hiddenLayers = net.getLayerCount() - 1;
+
+    // Mode: 0: Single Class, 1: Single Reg, 2: Multi Class, 3: Multi Reg
+    ui->cmbMode->setCurrentIndex((hiddenLayers > 0 ? 2 : 0) + (isRegression ? 1 : 0));
+    if(hiddenLayers > 0) {
+        ui->spinHiddenLayers->setValue(hiddenLayers);
+        ui->spinNeurons->setValue(net.getLayerSize(0));
+    }
+    if(!isRegression) {
+        ui->spinOutputLayer->setValue(net.getLayerSize(net.getLayerCount() - 1));
+        ui->cmbActivation->setCurrentText(net.getActivation() == ActivationType::TANH ? "TANH" : "SIGMOID");
+    }
+    ui->spinLR->setValue(state.learningRate);
+    ui->spinMaxEpochs->setValue(state.maxEpochs);
+    QStringList sparsity;
+    for(double s : state.pruneSparsity) sparsity << QString::number(s);
+    ui->editSparsity->setText(sparsity.isEmpty() ? "0" : sparsity.join(","));
+    pruneSparsity = state.pruneSparsity;
+    // CLI seeds are 64-bit; the run keeps the exact value even when the box cannot show it
+    runSeed = state.seed;
+    bool seedFits = state.seed <= (uint64_t)ui->spinSeed->maximum();
+    if(seedFits) ui->spinSeed->setValue((int)state.seed);
+    ui->cmbInit->setCurrentIndex((int)net.getInitType()); // Same order as InitType
+
+    // 2. Restore Network and Data
+    if(network) delete network;
+    network = new NeuralNetwork(state.network);
+    applyKernelTuning();
+
+    ui->renderArea->setNetwork(network);
+    ui->renderArea->setRegressionMode(isRegression);
+    ui->renderArea->setAxisRange(state.axisRange); // Inputs were normalized by it (0: older file, keep the canvas)
+    ui->renderArea->setData(state.points);
+    resetOnline();
+    ui->renderArea->setShowLines(true);
+    ui->renderArea->setVisualizeMode(false);
+
+    ui->widgetErrorGraph->clear();
+    for(double e : state.errorHistory) ui->widgetErrorGraph->addError(e);
+
+    ImportanceConfig importanceConfig;
+    importanceConfig.sampleFraction = state.importanceFraction;
+    importanceConfig.fullSweepInterval = state.fullSweepInterval;
+    sampler.setConfig(importanceConfig);
+    sampler.setLosses(state.sampleLosses);
+    ui->actionImportance->setChecked(state.importanceSampling);
+    ui->cmbOptimizer->setCurrentIndex((int)state.optimizer);
+    lbfgs.setHistory(state.lbfgsS, state.lbfgsY);
+
+    // 3. Restore Training Progress
+    runEpoch = state.epoch;
+    hasTrained = true;
+    ui->btnTrain->setText("Resume Training");
+    ui->btnTrain->setEnabled(true);
+    ui->btnTest->setEnabled(!isRegression);
+    ui->lblEpoch->setText(QString("Epoch: %1").arg(runEpoch));
+    ui->lblError->setText(state.errorHistory.empty() ? "Checkpoint loaded."
+                                                     : QString("Error: %1").arg(state.errorHistory.back()));
+    if(!seedFits) {
+        ui->statusbar->showMessage(QString("Seed %1 is kept for this run but is too large for the Seed box; "
+                                           "Create Network uses the box value").arg((qulonglong)state.seed));
+    }
+}
+
+void MainWindow::on_actionLoadPoints_triggered() {
+    if(isTraining) return;
+
+    QString path = QFileDialog::getOpenFileName(this, "Load Points", QString(),
+                                                "Point Files (*.csv *.txt);;All Files (*)");
+    if(path.isEmpty()) return;
+
+    // "x,y,class" (or "x,y" for regression) in world coordinates, same format as the CLI
+    std::vector<DataPoint> points;
+    if(!Dataset::loadPoints(path.toStdString(), points) || points.empty()) {
+        ui->lblError->setText("Could not read points.");
+        return;
+    }
+
+    ui->renderArea->setData(points);
+    resetOnline();
+
+    size_t visible = ui->renderArea->getVisibleCount();
+    QString message = QString("Loaded %1 points").arg(points.size());
+    if(visible < points.size()) message += QString(" (%1 outside the axis range)").arg(points.size() - visible);
+    ui->statusbar->showMessage(message, 5000);
+}
+
+void MainWindow::on_actionOnline_toggled(bool checked) {
+    if(checked) {
+        resetOnline(); // Points added while online mode was off are in the rebuilt set
+        onlineTimer->start();
+    } else {
+        onlineTimer->stop();
+    }
+}
+
+void MainWindow::resetOnline() {
+    online.discardPending();
+    online.reset();
+    onlineDataValid = false;
+}
+
+void MainWindow::onlineTick() {
+    // The training loop drains the queue itself while it runs
+    if(!network || isTraining) return;
+
+    if(!onlineDataValid) {
+        onlineData = buildDataset();
+        online.discardPending();
+        onlineDataValid = true;
+    }
+
+    // Warm start: new points are appended and replayed on the current weights
+    online.drain(onlineData, ui->renderArea->getAxisRange());
+    if(!online.hasFreshPoints()) return;
+
+    double loss = online.trainTick(*network, onlineData, ui->spinLR->value());
+
+    hasTrained = true;
+    ui->btnTest->setEnabled(network->getMode() == TaskMode::CLASSIFICATION);
+    ui->lblError->setText(QString("Online error: %1 (%2 new)").arg(loss).arg(online.getFreshCount()));
+    ui->renderArea->update();
+}
+
+void MainWindow::applyKernelTuning() {
+    // Cached configs apply at once; a miss keeps the default kernels for now
+    if(!network || Autotuner::apply(*network, false)) return;
+    if(!ui->actionAutotune->isChecked() || tuningThread) return; // A finishing run checks again
+
+    // Benchmarking takes up to a few seconds: run it on a copy off the UI thread,
+    // with LOW pool priority so pool workers finish training chunks before its runs.
+    // The winner lands in the tuning cache, onTuningFinished() picks it up.
+    NeuralNetwork probe = *network;
+    tuningThread = QThread::create([probe]() mutable { Autotuner::apply(probe, true, TaskPriority::LOW); });
+    connect(tuningThread, &QThread::finished, this, &MainWindow::onTuningFinished);
+    tuningThread->start(QThread::LowPriority);
+    ui->statusbar->showMessage("Tuning inference kernels in the background...");
+}
+
+void MainWindow::onTuningFinished() {
+    tuningThread->deleteLater();
+    tuningThread = nullptr;
+    if(!network) {
+        ui->statusbar->clearMessage();
+        return;
+    }
+
+    // The network may have been replaced meanwhile: apply only a cached match,
+    // otherwise tune the new topology
+    if(Autotuner::apply(*network, false)) {
+        ui->statusbar->showMessage(QString("Tuned inference kernels: %1")
+                                   .arg(QString::fromStdString(Autotuner::describe(network->getKernelConfig()))), 5000);
+    } else {
+        ui->statusbar->clearMessage();
+        applyKernelTuning();
+    }
+}
+
+Dataset MainWindow::buildDataset() {
+    int modeIdx = ui->cmbMode->currentIndex();
+    bool isRegression = (modeIdx % 2 != 0);
+
+    TaskMode task = isRegression ? TaskMode::REGRESSION : TaskMode::CLASSIFICATION;
+    int outputSize = qMax(1, ui->spinOutputLayer->value());
+
+    return Dataset::fromPoints(ui->renderArea->getData(), ui->renderArea->getAxisRange(), task, outputSize);
+}
+
+void MainWindow::on_actionSweep_triggered() {
+    Dataset data = buildDataset();
+
+    if(data.empty()) {
+        ui->lblError->setText("No data points!");
+        return;
+    }
+
+    // Sweep trains its own networks; the current one is left untouched
+    SweepDialog dialog(data, this);
+    dialog.exec();
 }
 
 void MainWindow::on_btnTest_clicked() {
     // Switch to Visualization/Heatmap Mode
     ui->renderArea->setShowLines(false);
     ui->renderArea->setVisualizeMode(true);
+
+    // Score the clicked points (encoded for the network as created, not the current widgets)
+    if(network) {
+        evaluate(Dataset::fromPoints(ui->renderArea->getData(), ui->renderArea->getAxisRange(),
+                                     network->getMode(), network->getOutputSize()), "Accuracy");
+    }
+}
+
+void MainWindow::on_actionEvaluate_triggered() {
+    if(!network || isTraining) {
+        ui->lblError->setText("Create and train a network first.");
+        return;
+    }
+
+    QString path = QFileDialog::getOpenFileName(this, "Evaluate Test Set", QString(),
+                                                "Point Files (*.csv *.txt);;All Files (*)");
+    if(path.isEmpty()) return;
+
+    std::vector<DataPoint> points;
+    if(!Dataset::loadPoints(path.toStdString(), points) || points.empty()) {
+        ui->lblError->setText("Could not read test points.");
+        return;
+    }
+
+    // Same scaling and output width the network was trained with
+    Dataset data = Dataset::fromPoints(points, ui->renderArea->getAxisRange(), network->getMode(), network->getOutputSize());
+    EvaluationResult result = evaluate(data, "Test");
+
+    QMessageBox box(this);
+    box.setWindowTitle("Test Set Evaluation");
+    box.setText("<pre>" + QString::fromStdString(result.format()).toHtmlEscaped() + "</pre>");
+    box.exec();
+}
+
+EvaluationResult MainWindow::evaluate(const Dataset &data, const QString &label) {
+    network->prepareInference();
+    EvaluationResult result = Evaluator::evaluate(*network, data);
+
+    if(result.mode == TaskMode::REGRESSION) {
+        ui->lblAccuracy->setText(QString("Loss: %1").arg(result.meanLoss, 0, 'f', 4));
+    } else {
+        ui->lblAccuracy->setText(QString("%1: %2%").arg(label).arg(result.accuracy * 100.0, 0, 'f', 1));
+
+        QStringList classInfo;
+        for(int c = 0; c < result.classes; c++) {
+            classInfo << QString("C%1 %2").arg(c).arg(result.classLoss[c], 0, 'f', 4);
+        }
+        ui->statusbar->showMessage(QString("%1/%2 correct in %3 ms | Loss per class: %4")
+                                   .arg(result.correct).arg(result.samples)
+                                   .arg(result.wallTimeMs, 0, 'f', 2).arg(classInfo.join(", ")));
+    }
+
+    // Full report (confusion matrix) on hover
+    ui->lblAccuracy->setToolTip("<pre>" + QString::fromStdString(result.format()).toHtmlEscaped() + "</pre>");
+    return result;
 }
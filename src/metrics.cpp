@@ -0,0 +1,374 @@
+#include "metrics.h"
+#include "atomicfile.h"
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// A client that resets the connection must not raise SIGPIPE and kill the process:
+// Linux takes a per-call flag, macOS a socket option (SO_NOSIGPIPE), Windows has no signal
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+namespace {
+
+#ifdef _WIN32
+typedef SOCKET SocketHandle;
+#else
+typedef int SocketHandle;
+#endif
+
+const int POLL_MS = 200; // Blocking waits wake up this often to notice shutdown
+
+void closeSocket(SocketHandle s) {
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+bool setNonBlocking(SocketHandle s) {
+#ifdef _WIN32
+    u_long enable = 1;
+    return ioctlsocket(s, FIONBIO, &enable) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    return flags >= 0 && fcntl(s, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+// The last socket call failed only because a non-blocking socket was not ready
+bool wouldBlock() {
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+// Waits up to POLL_MS until 's' is readable (or writable). > 0 ready, 0 timeout, < 0 error
+int waitSocket(SocketHandle s, bool forWrite) {
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(s, &set);
+    timeval timeout = { 0, POLL_MS * 1000 };
+    return select((int)s + 1, forWrite ? nullptr : &set, forWrite ? &set : nullptr, nullptr, &timeout);
+}
+
+void addToDouble(std::atomic<uint64_t> &bits, double v) {
+    uint64_t oldBits = bits.load(std::memory_order_relaxed);
+    for (;;) {
+        double current;
+        memcpy(&current, &oldBits, sizeof(current));
+        double updated = current + v;
+        uint64_t newBits;
+        memcpy(&newBits, &updated, sizeof(newBits));
+        if (bits.compare_exchange_weak(oldBits, newBits, std::memory_order_relaxed)) return;
+    }
+}
+
+// Shortest of %.15g..%.17g that reads back as the same double: histogram bounds
+// become labels like le="0.1", and scrapers merge series by the exact string
+std::string formatNumber(double v) {
+    char buf[64];
+    for (int precision = 15; precision <= 17; precision++) {
+        snprintf(buf, sizeof(buf), "%.*g", precision, v);
+        if (strtod(buf, nullptr) == v) break;
+    }
+    return buf;
+}
+
+} // namespace
+
+// --- MetricHistogram ---
+
+MetricHistogram::MetricHistogram(const std::vector<double> &upperBounds)
+    : bounds(upperBounds), buckets(new std::atomic<uint64_t>[upperBounds.size() + 1])
+{
+    for (size_t i = 0; i <= bounds.size(); i++) buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void MetricHistogram::observe(double v) {
+    size_t i = 0;
+    while (i < bounds.size() && v > bounds[i]) i++;
+    buckets[i].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    addToDouble(sumBits, v);
+}
+
+double MetricHistogram::getSum() const {
+    uint64_t b = sumBits.load(std::memory_order_relaxed);
+    double v;
+    memcpy(&v, &b, sizeof(v));
+    return v;
+}
+
+// --- MetricsRegistry ---
+
+MetricsRegistry &MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+MetricCounter &MetricsRegistry::counter(const std::string &name, const std::string &help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    counters.emplace_back(new MetricCounter);
+    entries.push_back({ name, help, Kind::COUNTER, counters.back().get() });
+    return *counters.back();
+}
+
+MetricGauge &MetricsRegistry::gauge(const std::string &name, const std::string &help) {
+    std::lock_guard<std::mutex> lock(mutex);
+    gauges.emplace_back(new MetricGauge);
+    entries.push_back({ name, help, Kind::GAUGE, gauges.back().get() });
+    return *gauges.back();
+}
+
+MetricHistogram &MetricsRegistry::histogram(const std::string &name, const std::string &help, const std::vector<double> &bounds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    histograms.emplace_back(new MetricHistogram(bounds));
+    entries.push_back({ name, help, Kind::HISTOGRAM, histograms.back().get() });
+    return *histograms.back();
+}
+
+void MetricsRegistry::registerCounter(const std::string &name, const std::string &help, MetricCounter *external) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ name, help, Kind::COUNTER, external });
+}
+
+std::string MetricsRegistry::render() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::string out;
+
+    for (const Entry &e : entries) {
+        if (e.kind == Kind::COUNTER) {
+            out += "# TYPE " + e.name + " counter\n";
+            out += "# HELP " + e.name + " " + e.help + "\n";
+            out += e.name + "_total " + std::to_string(static_cast<MetricCounter*>(e.metric)->get()) + "\n";
+        } else if (e.kind == Kind::GAUGE) {
+            out += "# TYPE " + e.name + " gauge\n";
+            out += "# HELP " + e.name + " " + e.help + "\n";
+            out += e.name + " " + formatNumber(static_cast<MetricGauge*>(e.metric)->get()) + "\n";
+        } else {
+            const MetricHistogram *h = static_cast<MetricHistogram*>(e.metric);
+            out += "# TYPE " + e.name + " histogram\n";
+            out += "# HELP " + e.name + " " + e.help + "\n";
+
+            // Buckets are exposed cumulatively
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < h->getBounds().size(); i++) {
+                cumulative += h->getBucket(i);
+                out += e.name + "_bucket{le=\"" + formatNumber(h->getBounds()[i]) + "\"} " + std::to_string(cumulative) + "\n";
+            }
+            cumulative += h->getBucket(h->getBounds().size());
+            out += e.name + "_bucket{le=\"+Inf\"} " + std::to_string(cumulative) + "\n";
+            out += e.name + "_sum " + formatNumber(h->getSum()) + "\n";
+            out += e.name + "_count " + std::to_string(cumulative) + "\n";
+        }
+    }
+    out += "# EOF\n";
+    return out;
+}
+
+// --- CoreMetrics ---
+
+CoreMetrics &CoreMetrics::get() {
+    static CoreMetrics metrics = [] {
+        MetricsRegistry &r = MetricsRegistry::instance();
+#ifdef NEURONLAB_ALLOC_METRICS
+        r.registerCounter("neuronlab_allocations", "Heap allocations made by the process.", &allocationCounter());
+#endif
+        return CoreMetrics{
+            r.counter("neuronlab_train_samples", "Training samples processed."),
+            r.counter("neuronlab_train_epochs", "Training epochs completed."),
+            r.histogram("neuronlab_epoch_duration_seconds", "Wall time of one training epoch.",
+                        { 0.0001, 0.001, 0.01, 0.1, 1, 10, 60 }),
+            r.gauge("neuronlab_train_loss", "Summed error of the last completed epoch."),
+            r.gauge("neuronlab_train_samples_per_second", "Training throughput of the last completed epoch."),
+            r.counter("neuronlab_predict_calls", "Calls to NeuralNetwork::predict."),
+            r.histogram("neuronlab_predict_latency_seconds", "Latency of sampled predict calls.",
+                        { 1e-7, 1e-6, 1e-5, 1e-4, 1e-3, 1e-2 })
+        };
+    }();
+    return metrics;
+}
+
+void CoreMetrics::recordEpoch(size_t samples, double seconds, double loss) {
+    trainSamples.inc(samples);
+    trainEpochs.inc();
+    epochDuration.observe(seconds);
+    trainLoss.set(loss);
+    if (seconds > 0.0) samplesPerSecond.set(samples / seconds);
+}
+
+// --- MetricsExporter ---
+
+MetricsExporter::MetricsExporter() : stopping(false) {
+#ifdef _WIN32
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+}
+
+MetricsExporter::~MetricsExporter() {
+    stopping = true;
+    for (auto &t : threads) t.join();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+bool MetricsExporter::serveHttp(int port) {
+    auto fd = socket(AF_INET, SOCK_STREAM, 0);
+#ifdef _WIN32
+    if (fd == INVALID_SOCKET) return false;
+#else
+    if (fd < 0) return false;
+#endif
+
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    // Localhost only: metrics are not meant to leave the machine
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((unsigned short)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 8) != 0) {
+        closeSocket(fd);
+        return false;
+    }
+
+    threads.emplace_back(&MetricsExporter::httpLoop, this, (intptr_t)fd);
+    return true;
+}
+
+void MetricsExporter::httpLoop(intptr_t listenSocket) {
+    SocketHandle fd = (SocketHandle)listenSocket;
+
+    while (!stopping) {
+        // Wake up regularly to notice shutdown
+        if (waitSocket(fd, false) <= 0) continue;
+
+        auto client = accept(fd, nullptr, nullptr);
+#ifdef _WIN32
+        if (client == INVALID_SOCKET) continue;
+#else
+        if (client < 0) continue;
+#endif
+        serveClient((intptr_t)client);
+    }
+
+    closeSocket(fd);
+}
+
+void MetricsExporter::serveClient(intptr_t clientSocket) {
+    SocketHandle client = (SocketHandle)clientSocket;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CLIENT_TIMEOUT_MS);
+    auto expired = [&] { return stopping || std::chrono::steady_clock::now() >= deadline; };
+
+    // Every wait below is bounded by POLL_MS, so neither a silent client nor one
+    // that stops reading can hold the thread past the deadline or block shutdown
+    if (!setNonBlocking(client)) {
+        closeSocket(client);
+        return;
+    }
+#ifdef SO_NOSIGPIPE
+    int noSigpipe = 1;
+    setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigpipe, sizeof(noSigpipe));
+#endif
+
+    // --- Request (only the request line matters; read up to the end of the headers) ---
+    char request[2048];
+    size_t received = 0;
+    request[0] = '\0';
+    while (received < sizeof(request) - 1 && !strstr(request, "\r\n\r\n")) {
+        if (expired()) {
+            closeSocket(client);
+            return;
+        }
+        int ready = waitSocket(client, false);
+        if (ready == 0) continue;
+
+        int n = ready > 0 ? (int)recv(client, request + received, (int)(sizeof(request) - 1 - received), 0) : -1;
+        if (n < 0 && ready > 0 && wouldBlock()) continue;
+        if (n <= 0) {
+            // Closed or failed: answer what arrived if it already holds a request line
+            if (received == 0 || !strchr(request, '\n')) {
+                closeSocket(client);
+                return;
+            }
+            break;
+        }
+        received += n;
+        request[received] = '\0';
+    }
+
+    std::string body, status, contentType;
+    if (strncmp(request, "GET /metrics", 12) == 0) {
+        status = "200 OK";
+        contentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+        body = MetricsRegistry::instance().render();
+    } else {
+        status = "404 Not Found";
+        contentType = "text/plain";
+        body = "Not Found. Try /metrics\n";
+    }
+
+    std::string response = "HTTP/1.1 " + status + "\r\n"
+                           "Content-Type: " + contentType + "\r\n"
+                           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                           "Connection: close\r\n\r\n" + body;
+
+    // --- Response (partial sends are resumed; any error drops the client) ---
+    size_t sent = 0;
+    while (sent < response.size() && !expired()) {
+        int ready = waitSocket(client, true);
+        if (ready == 0) continue;
+        if (ready < 0) break;
+
+        int n = (int)send(client, response.data() + sent, (int)(response.size() - sent), SEND_FLAGS);
+        if (n < 0 && wouldBlock()) continue;
+        if (n <= 0) break;
+        sent += n;
+    }
+
+    closeSocket(client);
+}
+
+void MetricsExporter::writeTextfile(const std::string &path, int intervalMs) {
+    threads.emplace_back(&MetricsExporter::textfileLoop, this, path, intervalMs);
+}
+
+void MetricsExporter::textfileLoop(std::string path, int intervalMs) {
+    const int tickMs = 100;
+    int elapsed = intervalMs; // Write immediately on start
+
+    while (!stopping) {
+        if (elapsed >= intervalMs) {
+            writeFileAtomically(path, MetricsRegistry::instance().render());
+            elapsed = 0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(tickMs));
+        elapsed += tickMs;
+    }
+    writeFileAtomically(path, MetricsRegistry::instance().render()); // Final values
+}
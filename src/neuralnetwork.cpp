@@ -1,15 +1,27 @@
 #include "neuralnetwork.h"
-
-NeuralNetwork::NeuralNetwork() {
-    // Seed random number generator
-    srand(time(0));
+#include "random.h"
+#include "metrics.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+NeuralNetwork::NeuralNetwork(uint64_t rngSeed)
+    : activation(ActivationType::SIGMOID), mode(TaskMode::CLASSIFICATION),
+      initType(InitType::XAVIER), seed(rngSeed), generation(0), revision(0)
+{
 }
 
-void NeuralNetwork::setup(int inputSize, int hiddenLayers, int neuronsPerLayer, int outputSize, ActivationType actType, TaskMode taskMode) {
+void NeuralNetwork::setup(int inputSize, int hiddenLayers, int neuronsPerLayer, int outputSize, ActivationType actType, TaskMode taskMode,
+                          InitType init) {
 
     layers.clear();
     activation = actType;
     mode = taskMode;
+    initType = init;
 
     int prevSize = inputSize;
 
@@ -24,13 +36,6 @@ void NeuralNetwork::setup(int inputSize, int hiddenLayers, int neuronsPerLayer,
         l.biases.resize(neuronsPerLayer);
         l.weights.resize(neuronsPerLayer * prevSize);
 
-        // Random initialization for weights and biases
-        for(int n = 0; n < neuronsPerLayer; n++) {
-            l.biases[n] = randomWeight();
-            for(int w = 0; w < prevSize; w++) {
-                l.weights[n * prevSize + w] = randomWeight();
-            }
-        }
         layers.push_back(l);
         prevSize = neuronsPerLayer;
     }
@@ -45,40 +50,78 @@ void NeuralNetwork::setup(int inputSize, int hiddenLayers, int neuronsPerLayer,
     outL.biases.resize(outputSize);
     outL.weights.resize(outputSize * prevSize);
 
-    for(int n = 0; n < outputSize; n++) {
-        outL.biases[n] = randomWeight();
-        for(int w = 0; w < prevSize; w++) {
-            outL.weights[n * prevSize + w] = randomWeight();
-        }
-    }
     layers.push_back(outL);
+
+    // --- 3. RANDOM INITIALIZATION ---
+    for(size_t i = 0; i < layers.size(); i++) initializeLayer((int)i);
 }
 
 void NeuralNetwork::reset() {
     // Re-randomize all weights and biases without changing architecture
-    for(auto &layer : layers) {
-        for(int n = 0; n < layer.numNeurons; n++) {
-            layer.biases[n] = randomWeight();
-        }
-        for(size_t j = 0; j < layer.weights.size(); j++) {
-            layer.weights[j] = randomWeight();
-        }
+    generation++;
+    for(size_t i = 0; i < layers.size(); i++) {
+        Layer &layer = layers[i];
+
+        // Fresh weights are dense again
+        layer.mask.clear();
+        layer.sparse = CsrMatrix();
+        layer.sparseValid = false;
+        layer.useSparse = false;
+
+        initializeLayer((int)i);
     }
 }
 
-double NeuralNetwork::randomWeight() {
-    // Returns a random value between -1.0 and 1.0
-    return ((double)rand() / RAND_MAX) * 2.0 - 1.0;
+void NeuralNetwork::initializeLayer(int layerIdx) {
+    revision++;
+    Layer &layer = layers[layerIdx];
+    double fanIn = layer.numWeightsPerNeuron;
+    double fanOut = layer.numNeurons;
+
+    // Each layer owns two streams (weights, biases); value i only depends on i
+    uint64_t runSeed = seed ^ (generation * 0xA24BAED4963EE407ULL);
+    uint64_t weightStream = 2 * (uint64_t)layerIdx;
+    uint64_t biasStream = weightStream + 1;
+
+    auto fillRange = [&](size_t begin, size_t end) {
+        for(size_t j = begin; j < end; j++) {
+            double w;
+            if (initType == InitType::HE) {
+                // He: N(0, 2 / fanIn)
+                w = CounterRng::normalAt(runSeed, weightStream, j) * std::sqrt(2.0 / fanIn);
+            } else if (initType == InitType::XAVIER) {
+                // Xavier/Glorot: U(-a, a), a = sqrt(6 / (fanIn + fanOut))
+                double a = std::sqrt(6.0 / (fanIn + fanOut));
+                w = (CounterRng::uniformAt(runSeed, weightStream, j) * 2.0 - 1.0) * a;
+            } else {
+                // Legacy: U(-1, 1)
+                w = CounterRng::uniformAt(runSeed, weightStream, j) * 2.0 - 1.0;
+            }
+            layer.weights[j] = w;
+        }
+    };
+
+    // Large layers (e.g. MNIST inputs) are split across the shared pool;
+    // small ones fit in a single chunk and run inline
+    parallelFor(0, layer.weights.size(), 1 << 14, fillRange);
+
+    // Scaled initializers start biases at zero; legacy mode keeps random biases
+    for(int n = 0; n < layer.numNeurons; n++) {
+        layer.biases[n] = (initType == InitType::UNIFORM)
+            ? CounterRng::uniformAt(runSeed, biasStream, n) * 2.0 - 1.0
+            : 0.0;
+    }
+    layer.sparseValid = false;
 }
 
-double NeuralNetwork::activate(double x) {
+double NeuralNetwork::activate(double x) const {
     if (activation == ActivationType::TANH) return tanh(x);
     if (activation == ActivationType::LINEAR) return x;
     // Sigmoid: 1 / (1 + e^-x)
     return 1.0 / (1.0 + exp(-x));
 }
 
-double NeuralNetwork::activateDeriv(double y) {
+double NeuralNetwork::activateDeriv(double y) const {
     // y = activation output
     if (activation == ActivationType::TANH) return 1.0 - y * y;
     if (activation == ActivationType::LINEAR) return 1.0;
@@ -88,37 +131,245 @@ double NeuralNetwork::activateDeriv(double y) {
 
 // --- PREDICT (Feed Forward) ---
 std::vector<double> NeuralNetwork::predict(const std::vector<double> &inputs) {
-    std::vector<double> currentInputs = inputs;
+    // Telemetry: every call is counted, but only every PREDICT_SAMPLE_RATE-th
+    // call per thread reads the clock and feeds the latency histogram
+    CoreMetrics &metrics = CoreMetrics::get();
+    metrics.predictCalls.inc();
+    static thread_local unsigned callCount = 0;
+    if (++callCount % CoreMetrics::PREDICT_SAMPLE_RATE != 0) {
+        feedForward(inputs, true);
+        return layers.back().outputs;
+    }
 
-    for(size_t i = 0; i < layers.size(); i++) {
-        Layer &layer = layers[i];
-        bool isOutputLayer = (i == layers.size() - 1);
+    auto start = std::chrono::steady_clock::now();
+    feedForward(inputs, true);
+    std::vector<double> result = layers.back().outputs;
 
-        for(int n = 0; n < layer.numNeurons; n++) {
-            double sum = layer.biases[n];
+    metrics.predictLatency.observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return result;
+}
 
-            // Calculate weighted sum (Dot Product)
-            for(size_t w = 0; w < currentInputs.size(); w++) {
-                int weightIndex = n * layer.numWeightsPerNeuron + w;
-                sum += currentInputs[w] * layer.weights[weightIndex];
+namespace {
+
+// Dense pre-activations for B samples at once. Each sample still sums its
+// weights in input order, so the result matches the one-sample loop exactly;
+// the B accumulators are independent and vectorize across samples.
+template<int B>
+void denseRowBlock(const double *wRow, int numInputs, double bias, const double *in, int inStride,
+                   double *out, int outStride) {
+    double sum[B];
+    for(int l = 0; l < B; l++) sum[l] = bias;
+
+    for(int w = 0; w < numInputs; w++) {
+        double weight = wRow[w];
+        for(int l = 0; l < B; l++) sum[l] += in[l * inStride + w] * weight;
+    }
+    for(int l = 0; l < B; l++) out[l * outStride] = sum[l];
+}
+
+} // namespace
+
+void NeuralNetwork::forwardLayer(const Layer &layer, const double *in, double *out, size_t count,
+                                 bool sparse, bool linearOut) const {
+    // Samples are stored back to back: sample b reads in[b * inputs], writes out[b * neurons].
+    // The neuron loop is outermost so a weight row is reused across the whole batch.
+    int inStride = layer.numWeightsPerNeuron;
+    int outStride = layer.numNeurons;
+    int block = sparse ? 1 : kernel.sampleBlock;
+
+    for(int n = 0; n < layer.numNeurons; n++) {
+        const double *wRow = &layer.weights[n * layer.numWeightsPerNeuron];
+        size_t b = 0;
+
+        // Blocked dense path (pre-activation only)
+        auto runBlocks = [&](auto blockFn, size_t width) {
+            for(; b + width <= count; b += width) {
+                blockFn(wRow, layer.numWeightsPerNeuron, layer.biases[n], in + b * inStride, inStride,
+                        out + b * outStride + n, outStride);
             }
+        };
+        if (block >= 8) runBlocks(denseRowBlock<8>, 8);
+        if (block >= 4) runBlocks(denseRowBlock<4>, 4);
+        if (block >= 2) runBlocks(denseRowBlock<2>, 2);
+        if (!linearOut) {
+            for(size_t done = 0; done < b; done++) out[done * outStride + n] = activate(out[done * outStride + n]);
+        }
 
-            // Apply activation function
-            if (isOutputLayer && mode == TaskMode::REGRESSION) {
-                layer.outputs[n] = sum; // Linear output for regression
+        // Remaining samples one at a time
+        for(; b < count; b++) {
+            const double *x = in + b * inStride;
+            double sum = layer.biases[n];
+
+            // Calculate weighted sum (Dot Product)
+            if (sparse) {
+                const CsrMatrix &m = layer.sparse;
+                for(int k = m.rowPtr[n]; k < m.rowPtr[n+1]; k++) {
+                    sum += x[m.colIdx[k]] * m.values[k];
+                }
             } else {
-                layer.outputs[n] = activate(sum);
+                for(int w = 0; w < layer.numWeightsPerNeuron; w++) {
+                    sum += x[w] * wRow[w];
+                }
             }
+
+            // Apply activation function (linear output for regression)
+            out[b * outStride + n] = linearOut ? sum : activate(sum);
         }
-        currentInputs = layer.outputs;
     }
-    return currentInputs;
+}
+
+void NeuralNetwork::feedForward(const std::vector<double> &inputs, bool allowSparse) {
+    const double *in = inputs.data();
+
+    for(size_t i = 0; i < layers.size(); i++) {
+        Layer &layer = layers[i];
+        bool linearOut = (i == layers.size() - 1) && mode == TaskMode::REGRESSION;
+
+        // Pruned layers: refresh CSR values after training touched the weights
+        bool sparse = allowSparse && layer.useSparse;
+        if (sparse && !layer.sparseValid) rebuildSparse(layer);
+
+        forwardLayer(layer, in, layer.outputs.data(), 1, sparse, linearOut);
+        in = layer.outputs.data();
+    }
+}
+
+// --- INFER (const, thread-safe) ---
+void NeuralNetwork::prepareInference() {
+    for(Layer &layer : layers) {
+        if (layer.useSparse && !layer.sparseValid) rebuildSparse(layer);
+    }
+}
+
+void NeuralNetwork::infer(const std::vector<double> &inputs, std::vector<double> &outputs, std::vector<double> &scratch) const {
+    inferBatch(inputs.data(), 1, outputs, scratch);
+}
+
+void NeuralNetwork::inferBatch(const double *inputs, size_t count, std::vector<double> &outputs, std::vector<double> &scratch) const {
+    if (layers.empty() || count == 0) {
+        outputs.clear();
+        return;
+    }
+
+    // Activations ping-pong between the two halves of 'scratch'
+    size_t widest = 0;
+    for(const Layer &layer : layers) widest = std::max(widest, (size_t)layer.numNeurons);
+    size_t half = widest * count;
+    if (scratch.size() < 2 * half) scratch.resize(2 * half);
+
+    const double *in = inputs;
+    for(size_t i = 0; i < layers.size(); i++) {
+        const Layer &layer = layers[i];
+        bool linearOut = (i == layers.size() - 1) && mode == TaskMode::REGRESSION;
+        double *out = &scratch[(i % 2) * half];
+
+        // A stale CSR copy is never read here; prepareInference() refreshes it
+        forwardLayer(layer, in, out, count, layer.useSparse && layer.sparseValid, linearOut);
+        in = out;
+    }
+    outputs.assign(in, in + count * layers.back().numNeurons);
 }
 
 // --- TRAIN (Backpropagation) ---
+double NeuralNetwork::lossGradientBatch(const double *inputs, const double *targets, size_t count,
+                                        std::vector<double> &gradient, std::vector<double> &scratch) const {
+    if (layers.empty() || count == 0) return 0.0;
+    if (gradient.size() < getParameterCount()) gradient.resize(getParameterCount(), 0.0);
+
+    // Scratch layout: every layer's activations (kept for the backward pass),
+    // then two delta buffers that ping-pong while walking back
+    size_t widest = 0;
+    size_t activationSize = 0;
+    for(const Layer &layer : layers) {
+        widest = std::max(widest, (size_t)layer.numNeurons);
+        activationSize += layer.numNeurons * count;
+    }
+    size_t deltaSize = widest * count;
+    if (scratch.size() < activationSize + 2 * deltaSize) scratch.resize(activationSize + 2 * deltaSize);
+
+    std::vector<double *> activations(layers.size());
+    size_t offset = 0;
+    for(size_t i = 0; i < layers.size(); i++) {
+        activations[i] = &scratch[offset];
+        offset += layers[i].numNeurons * count;
+    }
+    double *delta = &scratch[activationSize];
+    double *prevDelta = delta + deltaSize;
+
+    // 1. Forward Pass (dense: masked weights are zero anyway)
+    const double *in = inputs;
+    for(size_t i = 0; i < layers.size(); i++) {
+        bool linearOut = (i == layers.size() - 1) && mode == TaskMode::REGRESSION;
+        forwardLayer(layers[i], in, activations[i], count, false, linearOut);
+        in = activations[i];
+    }
+
+    // 2. Output Deltas: dLoss/dPreActivation = (output - target) * f'(output)
+    const Layer &outputLayer = layers.back();
+    int outputs = outputLayer.numNeurons;
+    double loss = 0.0;
+    for(size_t b = 0; b < count; b++) {
+        for(int n = 0; n < outputs; n++) {
+            double y = activations.back()[b * outputs + n];
+            double error = targets[b * outputs + n] - y;
+            loss += 0.5 * (error * error);
+            double derivative = (mode == TaskMode::REGRESSION) ? 1.0 : activateDeriv(y);
+            delta[b * outputs + n] = -error * derivative;
+        }
+    }
+
+    // 3. Walk Back: accumulate this layer's gradient, then propagate the deltas
+    size_t layerOffset = getParameterCount();
+    for(int i = (int)layers.size() - 1; i >= 0; i--) {
+        const Layer &layer = layers[i];
+        int numIn = layer.numWeightsPerNeuron;
+        int numOut = layer.numNeurons;
+        const double *layerIn = (i == 0) ? inputs : activations[i-1];
+
+        layerOffset -= layer.weights.size() + layer.biases.size();
+        double *weightGrad = &gradient[layerOffset];
+        double *biasGrad = weightGrad + layer.weights.size();
+
+        for(int n = 0; n < numOut; n++) {
+            double *row = weightGrad + (size_t)n * numIn;
+            double biasSum = 0.0;
+            for(size_t b = 0; b < count; b++) {
+                double d = delta[b * numOut + n];
+                const double *x = layerIn + b * numIn;
+                for(int w = 0; w < numIn; w++) row[w] += d * x[w];
+                biasSum += d;
+            }
+            biasGrad[n] += biasSum;
+        }
+
+        // Pruned weights get no gradient, so optimizers never move them off zero
+        if (!layer.mask.empty()) {
+            for(size_t j = 0; j < layer.weights.size(); j++) {
+                if (!layer.mask[j]) weightGrad[j] = 0.0;
+            }
+        }
+
+        if (i == 0) break;
+        for(size_t b = 0; b < count; b++) {
+            const double *d = delta + b * numOut;
+            const double *y = layerIn + b * numIn;
+            double *prev = prevDelta + b * numIn;
+            for(int w = 0; w < numIn; w++) prev[w] = 0.0;
+            for(int n = 0; n < numOut; n++) {
+                const double *wRow = &layer.weights[(size_t)n * numIn];
+                for(int w = 0; w < numIn; w++) prev[w] += d[n] * wRow[w];
+            }
+            for(int w = 0; w < numIn; w++) prev[w] *= activateDeriv(y[w]);
+        }
+        std::swap(delta, prevDelta);
+    }
+
+    return loss;
+}
+
 double NeuralNetwork::train(const std::vector<double> &inputs, const std::vector<double> &targets, double learningRate) {
-    // 1. Forward Pass
-    predict(inputs);
+    // 1. Forward Pass (dense: CSR would be stale after every update)
+    feedForward(inputs, false);
 
     Layer &outputLayer = layers.back();
     double totalError = 0.0;
@@ -173,12 +424,301 @@ double NeuralNetwork::train(const std::vector<double> &inputs, const std::vector
             // Bias Update
             layer.biases[n] += learningRate * layer.deltas[n];
         }
+
+        // Pruned weights must stay at zero
+        if (!layer.mask.empty()) {
+            for(size_t j = 0; j < layer.weights.size(); j++) {
+                if (!layer.mask[j]) layer.weights[j] = 0.0;
+            }
+        }
+        layer.sparseValid = false;
     }
+    revision++;
 
     return totalError;
 }
 
+// --- PRUNING ---
+void NeuralNetwork::prune(int layerIdx, double sparsity) {
+    if (layerIdx < 0 || (size_t)layerIdx >= layers.size()) return;
+    Layer &layer = layers[layerIdx];
+
+    sparsity = std::min(std::max(sparsity, 0.0), 1.0);
+    size_t count = layer.weights.size();
+    size_t pruneCount = (size_t)(sparsity * count);
+    if (layer.mask.empty()) layer.mask.assign(count, 1);
+
+    // Threshold = magnitude of the pruneCount-th smallest weight.
+    // Already pruned weights are zero, so pruning is monotonic across calls.
+    if (pruneCount > 0) {
+        std::vector<double> magnitudes(count);
+        for(size_t j = 0; j < count; j++) magnitudes[j] = std::abs(layer.weights[j]);
+        std::nth_element(magnitudes.begin(), magnitudes.begin() + (pruneCount - 1), magnitudes.end());
+        double threshold = magnitudes[pruneCount - 1];
+
+        size_t pruned = 0;
+        for(size_t j = 0; j < count && pruned < pruneCount; j++) {
+            if (!layer.mask[j] || std::abs(layer.weights[j]) <= threshold) {
+                layer.mask[j] = 0;
+                layer.weights[j] = 0.0;
+                pruned++;
+            }
+        }
+    }
+    rebuildSparse(layer);
+    revision++;
+}
+
+void NeuralNetwork::pruneAll(const std::vector<double> &layerSparsity) {
+    for(size_t i = 0; i < layers.size() && i < layerSparsity.size(); i++) {
+        if (layerSparsity[i] > 0.0) prune((int)i, layerSparsity[i]);
+    }
+}
+
+double NeuralNetwork::getSparsity(int layerIdx) const {
+    if (layerIdx < 0 || (size_t)layerIdx >= layers.size()) return 0.0;
+    const Layer &layer = layers[layerIdx];
+    if (layer.mask.empty() || layer.weights.empty()) return 0.0;
+
+    size_t zeros = std::count(layer.mask.begin(), layer.mask.end(), 0);
+    return (double)zeros / layer.weights.size();
+}
+
+double NeuralNetwork::pruneSchedule(double finalSparsity, int step, int totalSteps) {
+    if (totalSteps <= 0 || step >= totalSteps) return finalSparsity;
+    // Prune fast early while weights are still plastic, slowly near the end
+    double remaining = 1.0 - (double)step / totalSteps;
+    return finalSparsity * (1.0 - remaining * remaining * remaining);
+}
+
+bool NeuralNetwork::parseLayerSparsity(const std::string &text, int layerCount, std::vector<double> &layerSparsity) {
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::istringstream field(item);
+        double v;
+        if (!(field >> v) || !(v >= 0.0 && v < 1.0)) return false;
+        std::string rest;
+        if (field >> rest) return false; // Trailing garbage
+        values.push_back(v);
+    }
+
+    if (values.empty() || layerCount < 1) {
+        layerSparsity.assign(std::max(layerCount, 0), 0.0);
+        return values.empty();
+    }
+    if ((int)values.size() == layerCount) {
+        layerSparsity = values;
+        return true;
+    }
+    if (values.size() != 1) return false;
+
+    // One value: hidden layers only. The output layer is small and each of its
+    // weights matters, pruning it hard can cut a class off completely.
+    layerSparsity.assign(layerCount, values[0]);
+    layerSparsity.back() = 0.0;
+    return true;
+}
+
+bool NeuralNetwork::applyPruneSchedule(const std::vector<double> &finalSparsity, int epoch, int totalEpochs) {
+    if (std::none_of(finalSparsity.begin(), finalSparsity.end(), [](double s) { return s > 0.0; })) return false;
+
+    int pruneEnd = std::max(1, totalEpochs / 2);
+    int interval = std::max(1, pruneEnd / 10);
+    if (epoch > pruneEnd || (epoch % interval != 0 && epoch != pruneEnd)) return false;
+
+    std::vector<double> scheduled(finalSparsity.size());
+    for (size_t i = 0; i < scheduled.size(); i++) scheduled[i] = pruneSchedule(finalSparsity[i], epoch, pruneEnd);
+    pruneAll(scheduled);
+    return true;
+}
+
+void NeuralNetwork::rebuildSparse(Layer &layer) {
+    CsrMatrix &m = layer.sparse;
+    m.rowPtr.assign(layer.numNeurons + 1, 0);
+    m.colIdx.clear();
+    m.values.clear();
+
+    for(int n = 0; n < layer.numNeurons; n++) {
+        for(int w = 0; w < layer.numWeightsPerNeuron; w++) {
+            int idx = n * layer.numWeightsPerNeuron + w;
+            if (layer.mask.empty() || layer.mask[idx]) {
+                m.colIdx.push_back(w);
+                m.values.push_back(layer.weights[idx]);
+            }
+        }
+        m.rowPtr[n + 1] = (int)m.colIdx.size();
+    }
+    layer.sparseValid = true;
+}
+
+void NeuralNetwork::selectKernels() {
+    using Clock = std::chrono::steady_clock;
+    const int repeats = 200;
+
+    for(auto &layer : layers) {
+        layer.useSparse = false;
+        if (layer.mask.empty()) continue;
+        if (!layer.sparseValid) rebuildSparse(layer);
+
+        std::vector<double> in(layer.numWeightsPerNeuron, 0.5);
+        volatile double sink = 0.0;
+
+        // Dense kernel
+        auto t0 = Clock::now();
+        for(int r = 0; r < repeats; r++) {
+            for(int n = 0; n < layer.numNeurons; n++) {
+                double sum = 0.0;
+                const double *row = &layer.weights[n * layer.numWeightsPerNeuron];
+                for(int w = 0; w < layer.numWeightsPerNeuron; w++) sum += in[w] * row[w];
+                sink = sink + sum;
+            }
+        }
+
+        // CSR kernel
+        auto t1 = Clock::now();
+        const CsrMatrix &m = layer.sparse;
+        for(int r = 0; r < repeats; r++) {
+            for(int n = 0; n < layer.numNeurons; n++) {
+                double sum = 0.0;
+                for(int k = m.rowPtr[n]; k < m.rowPtr[n+1]; k++) sum += in[m.colIdx[k]] * m.values[k];
+                sink = sink + sum;
+            }
+        }
+        auto t2 = Clock::now();
+
+        layer.useSparse = (t2 - t1) < (t1 - t0);
+    }
+}
+
+// --- SERIALIZATION ---
+namespace {
+
+// Sanity limits for sizes read from a file, far above anything trainable here
+const uint32_t MAX_LAYERS = 1024;
+const int32_t MAX_LAYER_WIDTH = 1 << 20;
+
+template <typename T>
+void writeValue(std::ostream &out, const T &v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+void writeVector(std::ostream &out, const std::vector<T> &v) {
+    writeValue<uint32_t>(out, (uint32_t)v.size());
+    if (!v.empty()) out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::istream &in, T &v) {
+    return (bool)in.read(reinterpret_cast<char*>(&v), sizeof(T));
+}
+
+// The size comes from the (untrusted) stream: grow the vector chunk by chunk as
+// the data actually arrives, so a corrupt count fails on a short read instead
+// of allocating gigabytes up front
+template <typename T>
+bool readVector(std::istream &in, std::vector<T> &v, size_t maxSize) {
+    const size_t CHUNK = 65536;
+    uint32_t n = 0;
+    if (!readValue(in, n) || n > maxSize) return false;
+    v.clear();
+    while (v.size() < n) {
+        size_t at = v.size();
+        size_t take = std::min<size_t>(CHUNK, n - at);
+        v.resize(at + take);
+        if (!in.read(reinterpret_cast<char*>(v.data() + at), take * sizeof(T))) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void NeuralNetwork::save(std::ostream &out) const {
+    writeValue<int32_t>(out, (int32_t)activation);
+    writeValue<int32_t>(out, (int32_t)mode);
+    writeValue<int32_t>(out, (int32_t)initType);
+    writeValue<uint64_t>(out, seed);
+    writeValue<uint64_t>(out, generation);
+    writeValue<uint32_t>(out, (uint32_t)layers.size());
+
+    for (const auto &l : layers) {
+        writeValue<int32_t>(out, l.numNeurons);
+        writeValue<int32_t>(out, l.numWeightsPerNeuron);
+        writeVector(out, l.weights);
+        writeVector(out, l.biases);
+        writeVector(out, l.mask);
+        writeValue<uint8_t>(out, l.useSparse ? 1 : 0);
+    }
+}
+
+bool NeuralNetwork::load(std::istream &in) {
+    int32_t act = 0, taskMode = 0, init = 0;
+    uint64_t rngSeed = 0, rngGeneration = 0;
+    uint32_t layerCount = 0;
+    if (!readValue(in, act) || !readValue(in, taskMode) || !readValue(in, init)) return false;
+    if (!readValue(in, rngSeed) || !readValue(in, rngGeneration) || !readValue(in, layerCount)) return false;
+    if (act < 0 || act > (int32_t)ActivationType::LINEAR) return false;
+    if (taskMode < 0 || taskMode > (int32_t)TaskMode::REGRESSION) return false;
+    if (init < 0 || init > (int32_t)InitType::UNIFORM) return false;
+    if (layerCount == 0 || layerCount > MAX_LAYERS) return false;
+
+    std::vector<Layer> loaded(layerCount);
+    for (auto &l : loaded) {
+        int32_t neurons = 0, weightsPerNeuron = 0;
+        uint8_t sparseFlag = 0;
+        if (!readValue(in, neurons) || !readValue(in, weightsPerNeuron)) return false;
+        if (neurons <= 0 || weightsPerNeuron <= 0) return false;
+        if (neurons > MAX_LAYER_WIDTH || weightsPerNeuron > MAX_LAYER_WIDTH) return false;
+
+        size_t count = (size_t)neurons * weightsPerNeuron;
+        if (!readVector(in, l.weights, count) || l.weights.size() != count) return false;
+        if (!readVector(in, l.biases, neurons) || l.biases.size() != (size_t)neurons) return false;
+        if (!readVector(in, l.mask, count) || !readValue(in, sparseFlag)) return false;
+        if (!l.mask.empty() && l.mask.size() != count) return false;
+
+        l.numNeurons = neurons;
+        l.numWeightsPerNeuron = weightsPerNeuron;
+        l.outputs.assign(neurons, 0.0);
+        l.deltas.assign(neurons, 0.0);
+        l.useSparse = sparseFlag != 0;
+    }
+
+    for (size_t i = 1; i < loaded.size(); i++) {
+        if (loaded[i].numWeightsPerNeuron != loaded[i-1].numNeurons) return false;
+    }
+
+    // Commit only after the whole stream was valid
+    layers.swap(loaded);
+    activation = (ActivationType)act;
+    mode = (TaskMode)taskMode;
+    initType = (InitType)init;
+    seed = rngSeed;
+    generation = rngGeneration;
+    revision++;
+    for (auto &l : layers) {
+        if (!l.mask.empty()) rebuildSparse(l);
+    }
+    return true;
+}
+
 // --- Getters ---
+size_t NeuralNetwork::getParameterCount() const {
+    size_t count = 0;
+    for(const Layer &layer : layers) count += layer.weights.size() + layer.biases.size();
+    return count;
+}
+
+void NeuralNetwork::getParameters(std::vector<double> &params) const {
+    params.clear();
+    params.reserve(getParameterCount());
+    for(const Layer &layer : layers) {
+        params.insert(params.end(), layer.weights.begin(), layer.weights.end());
+        params.insert(params.end(), layer.biases.begin(), layer.biases.end());
+    }
+}
+
 double NeuralNetwork::getWeight(int layerIdx, int neuronIdx, int weightIdx) const {
     // Bounds check with safe casting
     if (layerIdx < 0 || (size_t)layerIdx >= layers.size()) return 0.0;
@@ -199,3 +739,46 @@ double NeuralNetwork::getBias(int layerIdx, int neuronIdx) const {
 
     return l.biases[neuronIdx];
 }
+
+// --- Setters ---
+void NeuralNetwork::setWeight(int layerIdx, int neuronIdx, int weightIdx, double value) {
+    if (layerIdx < 0 || (size_t)layerIdx >= layers.size()) return;
+
+    Layer& l = layers[layerIdx];
+    if (neuronIdx < 0 || neuronIdx >= l.numNeurons) return;
+    if (weightIdx < 0 || weightIdx >= l.numWeightsPerNeuron) return;
+
+    l.weights[neuronIdx * l.numWeightsPerNeuron + weightIdx] = value;
+    l.sparseValid = false;
+    revision++;
+}
+
+void NeuralNetwork::setBias(int layerIdx, int neuronIdx, double value) {
+    if (layerIdx < 0 || (size_t)layerIdx >= layers.size()) return;
+
+    Layer& l = layers[layerIdx];
+    if (neuronIdx < 0 || neuronIdx >= l.numNeurons) return;
+
+    l.biases[neuronIdx] = value;
+    revision++;
+}
+
+void NeuralNetwork::setParameters(const std::vector<double> &params) {
+    if (params.size() != getParameterCount()) return;
+
+    size_t offset = 0;
+    for(Layer &layer : layers) {
+        std::copy(params.begin() + offset, params.begin() + offset + layer.weights.size(), layer.weights.begin());
+        offset += layer.weights.size();
+        std::copy(params.begin() + offset, params.begin() + offset + layer.biases.size(), layer.biases.begin());
+        offset += layer.biases.size();
+
+        if (!layer.mask.empty()) {
+            for(size_t j = 0; j < layer.weights.size(); j++) {
+                if (!layer.mask[j]) layer.weights[j] = 0.0;
+            }
+        }
+        layer.sparseValid = false;
+    }
+    revision++;
+}
@@ -0,0 +1,68 @@
+#include "onlinetrainer.h"
+#include "random.h"
+#include <algorithm>
+
+OnlineTrainer::OnlineTrainer(const OnlineConfig &onlineConfig)
+    : config(onlineConfig), drawCounter(0)
+{
+}
+
+size_t OnlineTrainer::drain(Dataset &data, double range) {
+    size_t added = 0;
+    DataPoint p;
+    while (queue.pop(p)) {
+        data.append(p, range);
+        fresh.push_back(data.size() - 1);
+        remaining.push_back(std::max(1, config.replayVisits));
+        added++;
+    }
+    return added;
+}
+
+void OnlineTrainer::discardPending() {
+    DataPoint p;
+    while (queue.pop(p)) {}
+}
+
+void OnlineTrainer::reset() {
+    fresh.clear();
+    remaining.clear();
+    drawCounter = 0;
+}
+
+double OnlineTrainer::trainTick(NeuralNetwork &network, const Dataset &data, double learningRate) {
+    size_t n = data.size();
+    if (n == 0 || fresh.empty() || network.getLayerCount() == 0) return 0.0;
+    double targetMin = Dataset::targetMinFor(network.getActivation());
+
+    // Draw weight: old points 1 each, fresh points 'replayWeight' each
+    double weight = std::max(1.0, config.replayWeight);
+    double totalError = 0.0;
+    int steps = 0;
+
+    for (; steps < config.stepsPerTick && !fresh.empty(); steps++) {
+        double total = (double)(n - fresh.size()) + weight * fresh.size();
+        double u = CounterRng::uniformAt(network.getSeed(), RngStream::ONLINE, drawCounter++) * total;
+
+        size_t i;
+        if (u < weight * fresh.size()) {
+            // Replay a fresh point; it becomes an ordinary one after its last visit
+            size_t slot = std::min(fresh.size() - 1, (size_t)(u / weight));
+            i = fresh[slot];
+            if (--remaining[slot] == 0) {
+                fresh[slot] = fresh.back();
+                remaining[slot] = remaining.back();
+                fresh.pop_back();
+                remaining.pop_back();
+            }
+        } else {
+            // Rehearse any point (uniform) so the existing boundary holds
+            double old = std::max(1.0, (double)(n - fresh.size()));
+            i = std::min(n - 1, (size_t)((u - weight * fresh.size()) / old * n));
+        }
+
+        data.buildTarget(i, targetMin, target);
+        totalError += network.train(data.inputs[i], target, learningRate);
+    }
+    return steps > 0 ? totalError / steps : 0.0;
+}
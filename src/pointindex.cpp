@@ -0,0 +1,45 @@
+#include "pointindex.h"
+
+PointIndex::PointIndex()
+    : cells(CELLS * CELLS), range(1.0), indexed(0)
+{
+}
+
+void PointIndex::clear() {
+    for (auto &cell : cells) cell.clear();
+    indexed = 0;
+}
+
+void PointIndex::build(const std::vector<DataPoint> &points, double axisRange) {
+    clear();
+    range = axisRange > 0.0 ? axisRange : 1.0;
+    for (size_t i = 0; i < points.size(); i++) add(points[i], (uint32_t)i);
+}
+
+int PointIndex::cellOf(double v) const {
+    if (!(v >= -range && v <= range)) return -1; // Also rejects NaN
+    int cell = (int)((v + range) / (2.0 * range) * CELLS);
+    return std::min(cell, CELLS - 1); // v == range lands in the last cell
+}
+
+void PointIndex::add(const DataPoint &p, uint32_t index) {
+    int c = cellOf(p.x);
+    int r = cellOf(p.y);
+    if (c < 0 || r < 0) return;
+
+    cells[r * CELLS + c].push_back(index);
+    indexed++;
+}
+
+bool PointIndex::cellRange(double x0, double y0, double x1, double y1, int &c0, int &r0, int &c1, int &r1) const {
+    if (x0 > x1) std::swap(x0, x1);
+    if (y0 > y1) std::swap(y0, y1);
+    if (x1 < -range || x0 > range || y1 < -range || y0 > range) return false;
+
+    // Clamp to the indexed square, then map to cells
+    c0 = cellOf(std::max(x0, -range));
+    c1 = cellOf(std::min(x1, range));
+    r0 = cellOf(std::max(y0, -range));
+    r1 = cellOf(std::min(y1, range));
+    return c0 >= 0 && c1 >= 0 && r0 >= 0 && r1 >= 0;
+}
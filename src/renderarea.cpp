@@ -1,12 +1,16 @@
 #include "renderarea.h"
+#include "threadpool.h"
 #include <QPainter>
 #include <QPainterPath>
+#include <QVector>
 #include <QMouseEvent>
+#include <algorithm>
 #include <cmath>
 
 RenderArea::RenderArea(QWidget *parent)
     : QWidget(parent), isRegression(false), network(nullptr),
-      currentClass(0), visualizeDecision(false), showNeuronLines(false), axisRange(10.0)
+      currentClass(0), visualizeDecision(false), showNeuronLines(false), axisRange(10.0),
+      ingestQueue(nullptr), heatmapRevision(0), heatmapValid(false), densityValid(false)
 {
     // Set background color to system base color (usually white)
     setBackgroundRole(QPalette::Base);
@@ -15,7 +19,7 @@ RenderArea::RenderArea(QWidget *parent)
 
 // --- COORDINATE TRANSFORMATION HELPERS ---
 
-QPoint RenderArea::toScreen(double worldX, double worldY) {
+QPoint RenderArea::toScreen(double worldX, double worldY) const {
     int w = width();
     int h = height();
     int centerX = w / 2;
@@ -27,9 +31,13 @@ QPoint RenderArea::toScreen(double worldX, double worldY) {
     return QPoint(px, py);
 }
 
-DataPoint RenderArea::toWorld(int screenX, int screenY) {
-    int w = width();
-    int h = height();
+DataPoint RenderArea::toWorld(int screenX, int screenY) const {
+    return toWorld(screenX, screenY, size());
+}
+
+DataPoint RenderArea::toWorld(int screenX, int screenY, const QSize &viewport) const {
+    int w = viewport.width();
+    int h = viewport.height();
     int centerX = w / 2;
     int centerY = h / 2;
 
@@ -39,10 +47,36 @@ DataPoint RenderArea::toWorld(int screenX, int screenY) {
     return {wx, wy, 0};
 }
 
-QColor RenderArea::getClassColor(int classId) {
+QColor RenderArea::getClassColor(int classId) const {
     // Define a palette for different classes
-    const QColor colors[] = { Qt::red, Qt::blue, Qt::green, Qt::yellow, Qt::cyan, Qt::magenta };
-    return colors[classId % 6];
+    const QColor colors[COLOR_COUNT] = { Qt::red, Qt::blue, Qt::green, Qt::yellow, Qt::cyan, Qt::magenta };
+    return colors[colorSlot(classId)];
+}
+
+// --- DATA MANAGEMENT ---
+
+void RenderArea::clearData() {
+    data.clear();
+    index.clear();
+    densityValid = false;
+    update();
+}
+
+void RenderArea::setData(const std::vector<DataPoint> &points) {
+    data = points;
+    index.build(data, axisRange);
+    densityValid = false;
+    update();
+}
+
+void RenderArea::setAxisRange(double range) {
+    if (!(range > 0.0) || range == axisRange) return;
+    axisRange = range;
+    gridCache = QPixmap(); // Grid spacing changes with the range
+    index.build(data, axisRange);
+    heatmapValid = false;
+    densityValid = false;
+    update();
 }
 
 // --- EVENTS ---
@@ -52,16 +86,35 @@ void RenderArea::mousePressEvent(QMouseEvent *event) {
     DataPoint p = toWorld(event->x(), event->y());
     p.classID = currentClass;
 
+    bool wasDensity = index.getIndexedCount() > DENSITY_THRESHOLD;
     data.push_back(p);
-    update(); // Trigger repaint
+    index.add(p, (uint32_t)(data.size() - 1));
+    addToDensity(p);
+    if (ingestQueue) ingestQueue->push(p); // Picked up by the running trainer, no data copy
+
+    // Crossing the threshold switches every marker to the density image
+    if (wasDensity != (index.getIndexedCount() > DENSITY_THRESHOLD)) {
+        update();
+        return;
+    }
+
+    // Otherwise only the new marker needs repainting
+    int extent = POINT_RADIUS + 2;
+    update(QRect(event->pos() - QPoint(extent, extent), QSize(2 * extent, 2 * extent)));
+}
+
+void RenderArea::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    heatmapValid = false;
+    densityValid = false; // The grid layer notices the new size itself
 }
 
-void RenderArea::paintEvent(QPaintEvent *) {
+void RenderArea::paintEvent(QPaintEvent *event) {
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
 
-    // 1. Draw Grid and Axes
-    drawGrid(painter);
+    // 1. Draw Grid and Axes (cached layer; Qt clips the blit to the dirty region)
+    painter.drawPixmap(0, 0, gridLayer());
+    painter.setRenderHint(QPainter::Antialiasing);
 
     // 2. Draw Background Heatmap (Visualization Mode)
     if (visualizeDecision && network) {
@@ -78,7 +131,7 @@ void RenderArea::paintEvent(QPaintEvent *) {
     }
 
     // 4. Draw User Data Points
-    drawDataPoints(painter);
+    drawDataPoints(painter, event->rect());
 }
 
 // --- DRAWING IMPLEMENTATIONS ---
@@ -113,42 +166,82 @@ void RenderArea::drawGrid(QPainter &painter) {
 }
 
 void RenderArea::drawHeatmap(QPainter &painter) {
+    // Inference over the whole canvas reruns only when the network changed;
+    // a click's small repaint blits its rectangle of the cached image
+    if (!heatmapValid || heatmapRevision != network->getRevision()) rebuildHeatmap();
+    painter.drawImage(0, 0, heatmapImage);
+}
+
+void RenderArea::rebuildHeatmap() {
     int w = width();
     int h = height();
     int resolution = 6; // Lower value = Higher quality but slower performance
 
-    for (int x = 0; x < w; x += resolution) {
-        for (int y = 0; y < h; y += resolution) {
-
-            // Pixel -> World
-            DataPoint p = toWorld(x, y);
-
-            // Normalize input for the network
-            std::vector<double> input = { p.x / axisRange, p.y / axisRange };
-            auto output = network->predict(input);
-
-            if(output.empty()) continue;
-
-            QColor c;
-            if (isRegression) {
-                // Regression Mode: Grayscale mapping
-                // Map output from [-1, 1] to [0, 255]
-                double val = (output[0] + 1.0) / 2.0 * 255.0;
-                if(val < 0) val = 0; if(val > 255) val = 255;
-                c = QColor((int)val, (int)val, (int)val);
-            } else {
-                // Classification Mode: Winner-Takes-All color
-                int maxIdx = 0;
-                double maxVal = output[0];
-                for(size_t i = 1; i < output.size(); i++) {
-                    if(output[i] > maxVal) { maxVal = output[i]; maxIdx = i; }
+    int cols = (w + resolution - 1) / resolution;
+    int rows = (h + resolution - 1) / resolution;
+    std::vector<QColor> cells(cols * rows);
+    std::vector<unsigned char> valid(cols * rows, 0); // Not vector<bool>: chunks write concurrently
+
+    // Evaluate the grid on the shared pool (low priority: training work goes first).
+    // Each column is one inferBatch() call through the tuned kernels. Workers must not
+    // touch the QWidget, so the viewport size is read here on the UI thread.
+    network->prepareInference();
+    int inputSize = network->getInputSize(); // 2 (x, y) for classification, 1 (x) for regression
+    int outputSize = network->getOutputSize();
+    const QSize viewport(w, h);
+    parallelFor(0, cols, 4, [&](size_t colBegin, size_t colEnd) {
+        std::vector<double> inputs(rows * inputSize), outputs, scratch;
+
+        for (size_t col = colBegin; col < colEnd; col++) {
+            for (int row = 0; row < rows; row++) {
+                // Pixel -> World, normalized for the network
+                DataPoint p = toWorld((int)col * resolution, row * resolution, viewport);
+                inputs[row * inputSize] = p.x / axisRange;
+                if (inputSize > 1) inputs[row * inputSize + 1] = p.y / axisRange;
+            }
+            network->inferBatch(inputs.data(), rows, outputs, scratch);
+
+            if(outputs.empty()) continue;
+
+            for (int row = 0; row < rows; row++) {
+                const double *output = &outputs[row * outputSize];
+
+                QColor c;
+                if (isRegression) {
+                    // Regression Mode: Grayscale mapping
+                    // Map output from [-1, 1] to [0, 255]
+                    double val = (output[0] + 1.0) / 2.0 * 255.0;
+                    if(val < 0) val = 0; if(val > 255) val = 255;
+                    c = QColor((int)val, (int)val, (int)val);
+                } else {
+                    // Classification Mode: Winner-Takes-All color
+                    int maxIdx = 0;
+                    double maxVal = output[0];
+                    for(int i = 1; i < outputSize; i++) {
+                        if(output[i] > maxVal) { maxVal = output[i]; maxIdx = i; }
+                    }
+                    c = getClassColor(maxIdx);
                 }
-                c = getClassColor(maxIdx);
+                c.setAlpha(60); // Semi-transparent
+                cells[row * cols + col] = c;
+                valid[row * cols + col] = 1;
             }
-            c.setAlpha(60); // Semi-transparent
-            painter.fillRect(x, y, resolution, resolution, c);
+        }
+    }, TaskPriority::LOW);
+
+    // QPainter is not thread-safe: fill on the UI thread
+    heatmapImage = QImage(w, h, QImage::Format_ARGB32_Premultiplied);
+    heatmapImage.fill(Qt::transparent);
+    QPainter painter(&heatmapImage);
+    for (int col = 0; col < cols; col++) {
+        for (int row = 0; row < rows; row++) {
+            if (!valid[row * cols + col]) continue;
+            painter.fillRect(col * resolution, row * resolution, resolution, resolution, cells[row * cols + col]);
         }
     }
+
+    heatmapRevision = network->getRevision();
+    heatmapValid = true;
 }
 
 void RenderArea::drawRegressionCurve(QPainter &painter) {
@@ -214,12 +307,105 @@ void RenderArea::drawNeuronLines(QPainter &painter) {
     }
 }
 
-void RenderArea::drawDataPoints(QPainter &painter) {
-    for (const auto &p : data) {
-        painter.setBrush(getClassColor(p.classID));
-        painter.setPen(Qt::black);
+void RenderArea::drawDataPoints(QPainter &painter, const QRect &dirty) {
+    if (data.empty()) return;
+
+    // Level of detail: past DENSITY_THRESHOLD markers merge into a solid blob,
+    // a per-pixel density image shows more and costs one blit
+    if (index.getIndexedCount() > DENSITY_THRESHOLD) {
+        if (!densityValid) rebuildDensity();
+        painter.drawImage(dirty, densityImage, dirty);
+        return;
+    }
+
+    // Culling: only cells under the dirty rectangle, grown by a marker
+    QRect area = dirty.adjusted(-POINT_RADIUS - 1, -POINT_RADIUS - 1, POINT_RADIUS + 1, POINT_RADIUS + 1);
+    DataPoint topLeft = toWorld(area.left(), area.top());
+    DataPoint bottomRight = toWorld(area.right(), area.bottom());
+
+    // Batched drawing: bucket fragments by color, then one drawPixmapFragments()
+    // call per pre-rendered sprite. All sprites share one size and pixel ratio;
+    // the fragment scale maps device pixels back to widget coordinates.
+    const QPixmap &firstSprite = markerSprite(0);
+    QRectF source(firstSprite.rect());
+    qreal scale = 1.0 / firstSprite.devicePixelRatio();
+
+    QVector<QPainter::PixmapFragment> buckets[COLOR_COUNT];
+    index.forEachIn(topLeft.x, bottomRight.y, bottomRight.x, topLeft.y, [&](uint32_t i) {
+        const DataPoint &p = data[i];
+        buckets[colorSlot(p.classID)].append(QPainter::PixmapFragment::create(QPointF(toScreen(p.x, p.y)), source, scale, scale));
+    });
+
+    for (int c = 0; c < COLOR_COUNT; c++) {
+        if (buckets[c].isEmpty()) continue;
+        painter.drawPixmapFragments(buckets[c].constData(), buckets[c].size(), markerSprite(c));
+    }
+}
+
+// --- CACHED LAYERS ---
 
-        QPoint center = toScreen(p.x, p.y);
-        painter.drawEllipse(center, 6, 6);
+const QPixmap &RenderArea::gridLayer() {
+    qreal dpr = devicePixelRatioF();
+    QSize pixels = size() * dpr;
+    if (gridCache.size() != pixels) {
+        gridCache = QPixmap(pixels);
+        gridCache.setDevicePixelRatio(dpr);
+        gridCache.fill(palette().color(QPalette::Base));
+
+        QPainter layer(&gridCache);
+        layer.setRenderHint(QPainter::Antialiasing);
+        drawGrid(layer);
     }
+    return gridCache;
+}
+
+const QPixmap &RenderArea::markerSprite(int colorIdx) {
+    QPixmap &sprite = markerCache[colorIdx];
+    qreal dpr = devicePixelRatioF();
+    if (sprite.isNull() || sprite.devicePixelRatio() != dpr) {
+        // Same look as the old per-point drawEllipse: class color, black outline
+        int side = 2 * POINT_RADIUS + 2;
+        sprite = QPixmap(QSize(side, side) * dpr);
+        sprite.setDevicePixelRatio(dpr);
+        sprite.fill(Qt::transparent);
+
+        QPainter marker(&sprite);
+        marker.setRenderHint(QPainter::Antialiasing);
+        marker.setBrush(getClassColor(colorIdx));
+        marker.setPen(Qt::black);
+        marker.drawEllipse(QPointF(side / 2.0, side / 2.0), POINT_RADIUS, POINT_RADIUS);
+    }
+    return sprite;
+}
+
+void RenderArea::rebuildDensity() {
+    int w = width();
+    int h = height();
+    densityImage = QImage(w, h, QImage::Format_ARGB32_Premultiplied);
+    densityImage.fill(Qt::transparent);
+    densityCount.assign((size_t)w * h, 0);
+    densityColor.assign((size_t)w * h * 3, 0.0f);
+    densityValid = true;
+
+    index.forEachIn(-axisRange, -axisRange, axisRange, axisRange, [&](uint32_t i) { addToDensity(data[i]); });
+}
+
+void RenderArea::addToDensity(const DataPoint &p) {
+    if (!densityValid) return;
+
+    QPoint pixel = toScreen(p.x, p.y);
+    if (pixel.x() < 0 || pixel.y() < 0 || pixel.x() >= densityImage.width() || pixel.y() >= densityImage.height()) return;
+
+    size_t idx = (size_t)pixel.y() * densityImage.width() + pixel.x();
+    QColor color = getClassColor(p.classID);
+    uint32_t count = ++densityCount[idx];
+    float *sum = &densityColor[idx * 3];
+    sum[0] += color.red();
+    sum[1] += color.green();
+    sum[2] += color.blue();
+
+    // Mean class color, opacity on a log scale of the count (1 point: 90, 16+ points: opaque)
+    int alpha = std::min(255, 90 + (int)(40.0 * std::log2((double)count)));
+    QRgb rgb = qRgba((int)(sum[0] / count), (int)(sum[1] / count), (int)(sum[2] / count), alpha);
+    reinterpret_cast<QRgb*>(densityImage.scanLine(pixel.y()))[pixel.x()] = qPremultiply(rgb);
 }
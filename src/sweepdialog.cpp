@@ -0,0 +1,157 @@
+#include "sweepdialog.h"
+#include "sweepengine.h"
+#include "threadpool.h"
+#include <QCheckBox>
+#include <QComboBox>
+#include <QFormLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QTableWidget>
+#include <QThread>
+#include <QVBoxLayout>
+
+SweepDialog::SweepDialog(const Dataset &data, QWidget *parent)
+    : QDialog(parent), dataset(data), sweepThread(nullptr)
+{
+    setWindowTitle("Hyper-parameter Sweep");
+    resize(640, 480);
+
+    // --- Grid Configuration ---
+    editLearningRates = new QLineEdit("0.1, 0.05, 0.01, 0.005");
+    editHiddenLayers = new QLineEdit(dataset.mode == TaskMode::REGRESSION ? "1, 2" : "0, 1, 2");
+    editNeurons = new QLineEdit("4, 8");
+
+    chkSigmoid = new QCheckBox("SIGMOID");
+    chkTanh = new QCheckBox("TANH");
+    chkSigmoid->setChecked(dataset.mode == TaskMode::CLASSIFICATION);
+    chkTanh->setChecked(true);
+
+    QHBoxLayout *actLayout = new QHBoxLayout;
+    actLayout->addWidget(chkSigmoid);
+    actLayout->addWidget(chkTanh);
+    actLayout->addStretch();
+
+    spinEpochs = new QSpinBox;
+    spinEpochs->setRange(1, 100000);
+    spinEpochs->setValue(1000);
+
+    spinThreads = new QSpinBox;
+    spinThreads->setRange(1, ThreadPool::instance().getThreadCount());
+    spinThreads->setValue(ThreadPool::instance().getThreadCount());
+
+    // Same defaults as the CLI sweep (--seed 1 --init XAVIER)
+    spinSeed = new QSpinBox;
+    spinSeed->setRange(0, 2147483647);
+    spinSeed->setValue((int)NeuralNetwork::DEFAULT_SEED);
+    spinSeed->setToolTip("Every model starts from this seed; same-shape models share their initial weights");
+
+    cmbInit = new QComboBox;
+    cmbInit->addItems({ "XAVIER", "HE", "UNIFORM" }); // Same order as InitType
+
+    QFormLayout *form = new QFormLayout;
+    form->addRow("Learning Rates", editLearningRates);
+    form->addRow("Hidden Layers", editHiddenLayers);
+    form->addRow("Neurons Per Layer", editNeurons);
+    form->addRow("Activations", actLayout);
+    form->addRow("Epochs", spinEpochs);
+    form->addRow("Threads", spinThreads);
+    form->addRow("Seed", spinSeed);
+    form->addRow("Weight Init", cmbInit);
+
+    // --- Results Table ---
+    tableResults = new QTableWidget(0, 7);
+    tableResults->setHorizontalHeaderLabels({ "Rank", "Layers", "Neurons", "Activation", "LR", "Final Loss", "Time (ms)" });
+    tableResults->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    tableResults->verticalHeader()->setVisible(false);
+    tableResults->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    btnRun = new QPushButton("Run Sweep");
+    connect(btnRun, &QPushButton::clicked, this, &SweepDialog::runSweep);
+
+    lblStatus = new QLabel(QString("%1 samples").arg(dataset.size()));
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(form);
+    layout->addWidget(btnRun);
+    layout->addWidget(tableResults);
+    layout->addWidget(lblStatus);
+}
+
+SweepDialog::~SweepDialog() {
+    // reject() keeps the dialog open while training, this only covers the parent going away
+    if (sweepThread) {
+        sweepThread->wait();
+        delete sweepThread;
+    }
+}
+
+void SweepDialog::reject() {
+    if (sweepThread) {
+        lblStatus->setText("Sweep still running. Wait for it to finish before closing.");
+        return;
+    }
+    QDialog::reject();
+}
+
+void SweepDialog::runSweep() {
+    // Parse comma separated lists
+    std::vector<double> lrs;
+    std::vector<int> layers, neurons;
+    std::vector<ActivationType> acts;
+
+    for (const QString &s : editLearningRates->text().split(',', Qt::SkipEmptyParts)) lrs.push_back(s.trimmed().toDouble());
+    for (const QString &s : editHiddenLayers->text().split(',', Qt::SkipEmptyParts)) layers.push_back(s.trimmed().toInt());
+    for (const QString &s : editNeurons->text().split(',', Qt::SkipEmptyParts)) neurons.push_back(qMax(1, s.trimmed().toInt()));
+    if (chkSigmoid->isChecked()) acts.push_back(ActivationType::SIGMOID);
+    if (chkTanh->isChecked()) acts.push_back(ActivationType::TANH);
+
+    SweepConfig config;
+    config.candidates = SweepEngine::makeGrid(lrs, layers, neurons, acts);
+    config.epochs = spinEpochs->value();
+    config.threads = spinThreads->value();
+    config.seed = (uint64_t)spinSeed->value();
+    config.init = (InitType)cmbInit->currentIndex();
+
+    if (config.candidates.empty()) {
+        lblStatus->setText("Empty grid. Check the parameter lists.");
+        return;
+    }
+
+    // Dozens of models take a while: train them off the UI thread.
+    // onSweepFinished() fills the table once the thread is done.
+    btnRun->setEnabled(false);
+    lblStatus->setText(QString("Training %1 models...").arg(config.candidates.size()));
+
+    sweepThread = QThread::create([this, config]() { results = SweepEngine::run(config, dataset); });
+    connect(sweepThread, &QThread::finished, this, &SweepDialog::onSweepFinished);
+    sweepThread->start();
+}
+
+void SweepDialog::onSweepFinished() {
+    sweepThread->deleteLater();
+    sweepThread = nullptr;
+    btnRun->setEnabled(true);
+
+    // Fill ranked table
+    tableResults->setRowCount((int)results.size());
+    for (int i = 0; i < (int)results.size(); i++) {
+        const SweepResult &r = results[i];
+        QStringList cells = {
+            QString::number(i + 1),
+            QString::number(r.candidate.hiddenLayers),
+            QString::number(r.candidate.neuronsPerLayer),
+            SweepEngine::activationName(r.candidate.activation),
+            QString::number(r.candidate.learningRate),
+            QString::number(r.finalLoss, 'f', 6),
+            QString::number(r.wallTimeMs, 'f', 1)
+        };
+        for (int c = 0; c < cells.size(); c++) {
+            tableResults->setItem(i, c, new QTableWidgetItem(cells[c]));
+        }
+    }
+    lblStatus->setText(QString("Done. %1 models ranked by final loss.").arg(results.size()));
+}
@@ -0,0 +1,306 @@
+#include "sweepengine.h"
+#include "metrics.h"
+#include "threadpool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <tuple>
+
+namespace {
+
+const int L = SweepEngine::LANES;
+
+// Same layout as Layer, with every value widened to L lanes:
+// weights[(n * numInputs + w) * L + lane]
+struct PackedLayer {
+    int numNeurons;
+    int numInputs;
+    std::vector<double> weights;
+    std::vector<double> biases;
+    std::vector<double> outputs;
+    std::vector<double> deltas;
+};
+
+inline double activateValue(ActivationType act, double x) {
+    if (act == ActivationType::TANH) return tanh(x);
+    if (act == ActivationType::LINEAR) return x;
+    return 1.0 / (1.0 + exp(-x));
+}
+
+inline double activateDerivValue(ActivationType act, double y) {
+    if (act == ActivationType::TANH) return 1.0 - y * y;
+    if (act == ActivationType::LINEAR) return 1.0;
+    return y * (1.0 - y);
+}
+
+// Up to L same-shape networks trained in lock-step on the same sample stream.
+// The math per lane is identical to NeuralNetwork::train.
+class ModelPack {
+public:
+    ModelPack(const std::vector<NeuralNetwork*> &nets, const std::vector<double> &learningRates)
+        : activation(nets[0]->getActivation()), mode(nets[0]->getMode())
+    {
+        int prevSize = nets[0]->getInputSize();
+        inputBuf.assign(prevSize * L, 0.0);
+
+        for (int i = 0; i < nets[0]->getLayerCount(); i++) {
+            PackedLayer pl;
+            pl.numNeurons = nets[0]->getLayerSize(i);
+            pl.numInputs = prevSize;
+            pl.weights.assign(pl.numNeurons * prevSize * L, 0.0);
+            pl.biases.assign(pl.numNeurons * L, 0.0);
+            pl.outputs.assign(pl.numNeurons * L, 0.0);
+            pl.deltas.assign(pl.numNeurons * L, 0.0);
+
+            // Unused lanes keep zero weights and a zero learning rate
+            for (size_t lane = 0; lane < nets.size(); lane++) {
+                for (int n = 0; n < pl.numNeurons; n++) {
+                    pl.biases[n * L + lane] = nets[lane]->getBias(i, n);
+                    for (int w = 0; w < prevSize; w++) {
+                        pl.weights[(n * prevSize + w) * L + lane] = nets[lane]->getWeight(i, n, w);
+                    }
+                }
+            }
+            layers.push_back(pl);
+            prevSize = pl.numNeurons;
+        }
+
+        for (int lane = 0; lane < L; lane++) {
+            lr[lane] = (lane < (int)learningRates.size()) ? learningRates[lane] : 0.0;
+        }
+    }
+
+    // One SGD step on all lanes; adds each lane's sample error to laneError
+    void trainSample(const std::vector<double> &input, const std::vector<double> &target, double *laneError) {
+        // 1. Forward Pass (input is shared, broadcast it to every lane)
+        for (size_t w = 0; w < input.size(); w++) {
+            for (int l = 0; l < L; l++) inputBuf[w * L + l] = input[w];
+        }
+
+        const double *in = inputBuf.data();
+        for (size_t i = 0; i < layers.size(); i++) {
+            PackedLayer &layer = layers[i];
+            bool linearOut = (i == layers.size() - 1) && mode == TaskMode::REGRESSION;
+
+            for (int n = 0; n < layer.numNeurons; n++) {
+                double sum[L];
+                for (int l = 0; l < L; l++) sum[l] = layer.biases[n * L + l];
+
+                const double *wRow = &layer.weights[n * layer.numInputs * L];
+                for (int w = 0; w < layer.numInputs; w++) {
+                    for (int l = 0; l < L; l++) sum[l] += in[w * L + l] * wRow[w * L + l];
+                }
+
+                for (int l = 0; l < L; l++) {
+                    layer.outputs[n * L + l] = linearOut ? sum[l] : activateValue(activation, sum[l]);
+                }
+            }
+            in = layer.outputs.data();
+        }
+
+        // 2. Output Layer Deltas
+        PackedLayer &outputLayer = layers.back();
+        for (int n = 0; n < outputLayer.numNeurons; n++) {
+            for (int l = 0; l < L; l++) {
+                double out = outputLayer.outputs[n * L + l];
+                double error = target[n] - out;
+                laneError[l] += 0.5 * (error * error);
+
+                double derivative = (mode == TaskMode::REGRESSION) ? 1.0 : activateDerivValue(activation, out);
+                outputLayer.deltas[n * L + l] = error * derivative;
+            }
+        }
+
+        // 3. Hidden Layer Deltas
+        for (int i = (int)layers.size() - 2; i >= 0; i--) {
+            PackedLayer &curr = layers[i];
+            const PackedLayer &next = layers[i+1];
+
+            for (int n = 0; n < curr.numNeurons; n++) {
+                double propagated[L] = {};
+                for (int nextN = 0; nextN < next.numNeurons; nextN++) {
+                    const double *d = &next.deltas[nextN * L];
+                    const double *wv = &next.weights[(nextN * next.numInputs + n) * L];
+                    for (int l = 0; l < L; l++) propagated[l] += d[l] * wv[l];
+                }
+                for (int l = 0; l < L; l++) {
+                    curr.deltas[n * L + l] = propagated[l] * activateDerivValue(activation, curr.outputs[n * L + l]);
+                }
+            }
+        }
+
+        // 4. Update Weights and Biases
+        for (int i = (int)layers.size() - 1; i >= 0; i--) {
+            PackedLayer &layer = layers[i];
+            const double *layerIn = (i == 0) ? inputBuf.data() : layers[i-1].outputs.data();
+
+            for (int n = 0; n < layer.numNeurons; n++) {
+                double step[L];
+                for (int l = 0; l < L; l++) step[l] = lr[l] * layer.deltas[n * L + l];
+
+                double *wRow = &layer.weights[n * layer.numInputs * L];
+                for (int w = 0; w < layer.numInputs; w++) {
+                    for (int l = 0; l < L; l++) wRow[w * L + l] += step[l] * layerIn[w * L + l];
+                }
+                for (int l = 0; l < L; l++) layer.biases[n * L + l] += step[l];
+            }
+        }
+    }
+
+    // Copies the trained lanes back into their networks
+    void unpack(const std::vector<NeuralNetwork*> &nets) const {
+        for (size_t i = 0; i < layers.size(); i++) {
+            const PackedLayer &pl = layers[i];
+            for (size_t lane = 0; lane < nets.size(); lane++) {
+                for (int n = 0; n < pl.numNeurons; n++) {
+                    nets[lane]->setBias(i, n, pl.biases[n * L + lane]);
+                    for (int w = 0; w < pl.numInputs; w++) {
+                        nets[lane]->setWeight(i, n, w, pl.weights[(n * pl.numInputs + w) * L + lane]);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<PackedLayer> layers;
+    std::vector<double> inputBuf;
+    ActivationType activation;
+    TaskMode mode;
+    double lr[L];
+};
+
+} // namespace
+
+std::vector<SweepCandidate> SweepEngine::makeGrid(const std::vector<double> &learningRates,
+                                                  const std::vector<int> &hiddenLayers,
+                                                  const std::vector<int> &neurons,
+                                                  const std::vector<ActivationType> &activations) {
+    std::vector<SweepCandidate> grid;
+    for (ActivationType act : activations) {
+        for (int h : hiddenLayers) {
+            // Neuron count is meaningless without hidden layers, keep one entry
+            std::vector<int> neuronList = (h == 0) ? std::vector<int>{ neurons.empty() ? 1 : neurons[0] } : neurons;
+            for (int n : neuronList) {
+                for (double lr : learningRates) {
+                    grid.push_back({ h, n, act, lr });
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+std::vector<SweepResult> SweepEngine::run(const SweepConfig &config, const Dataset &data) {
+    std::vector<SweepResult> results(config.candidates.size());
+    if (config.candidates.empty() || data.empty()) return {};
+
+    for (size_t i = 0; i < config.candidates.size(); i++) results[i].candidate = config.candidates[i];
+
+    // --- 1. Group Same-Shape Candidates Into Packs ---
+    auto shapeKey = [&](size_t i) {
+        const SweepCandidate &c = config.candidates[i];
+        int neurons = (c.hiddenLayers == 0) ? 0 : c.neuronsPerLayer;
+        return std::make_tuple(c.hiddenLayers, neurons, (int)c.activation);
+    };
+
+    std::vector<size_t> order(config.candidates.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return shapeKey(a) < shapeKey(b); });
+
+    std::vector<std::vector<size_t>> packs;
+    for (size_t idx : order) {
+        if (packs.empty() || (int)packs.back().size() == LANES || shapeKey(packs.back()[0]) != shapeKey(idx)) {
+            packs.push_back({});
+        }
+        packs.back().push_back(idx);
+    }
+
+    // --- 2. Train Packs On Worker Threads ---
+    CoreMetrics &metrics = CoreMetrics::get();
+    std::atomic<size_t> nextPack(0);
+    auto worker = [&]() {
+        std::vector<double> target;
+        std::vector<size_t> order;
+        for (size_t p = nextPack++; p < packs.size(); p = nextPack++) {
+            const std::vector<size_t> &members = packs[p];
+            auto start = std::chrono::steady_clock::now();
+
+            // Initialization is counter-based, so building networks here is reproducible
+            std::vector<NeuralNetwork*> nets;
+            std::vector<double> lrs;
+            for (size_t idx : members) {
+                const SweepCandidate &c = config.candidates[idx];
+                results[idx].network = std::make_shared<NeuralNetwork>(config.seed);
+                results[idx].network->setup(data.inputSize, c.hiddenLayers, c.neuronsPerLayer, data.outputSize,
+                                            c.activation, data.mode, config.init);
+                nets.push_back(results[idx].network.get());
+                lrs.push_back(c.learningRate);
+            }
+
+            ModelPack pack(nets, lrs);
+            double targetMin = Dataset::targetMinFor(nets[0]->getActivation());
+            double laneError[LANES] = {};
+
+            for (int epoch = 0; epoch < config.epochs; epoch++) {
+                std::fill(laneError, laneError + LANES, 0.0);
+                data.epochOrder(config.seed, epoch, order);
+                for (size_t s : order) {
+                    data.buildTarget(s, targetMin, target);
+                    pack.trainSample(data.inputs[s], target, laneError);
+                }
+                metrics.trainSamples.inc(data.size() * members.size());
+            }
+            pack.unpack(nets);
+
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            for (size_t lane = 0; lane < members.size(); lane++) {
+                SweepResult &r = results[members[lane]];
+                r.finalLoss = laneError[lane];
+                r.wallTimeMs = ms;
+                r.group = (int)p;
+            }
+        }
+    };
+
+    // Each task keeps pulling packs, so 'threads' caps how many run at once
+    ThreadPool &pool = ThreadPool::instance();
+    int taskCount = config.threads > 0 ? std::min(config.threads, pool.getThreadCount()) : pool.getThreadCount();
+    taskCount = std::max(1, std::min(taskCount, (int)packs.size()));
+
+    TaskGroup group(TaskPriority::HIGH, pool);
+    for (int t = 1; t < taskCount; t++) group.run(worker);
+    worker(); // Calling thread works too
+    group.wait();
+
+    // --- 3. Rank By Final Loss ---
+    std::stable_sort(results.begin(), results.end(), [](const SweepResult &a, const SweepResult &b) {
+        return a.finalLoss < b.finalLoss;
+    });
+    return results;
+}
+
+const char *SweepEngine::activationName(ActivationType act) {
+    if (act == ActivationType::TANH) return "TANH";
+    if (act == ActivationType::LINEAR) return "LINEAR";
+    return "SIGMOID";
+}
+
+std::string SweepEngine::formatTable(const std::vector<SweepResult> &results) {
+    std::string out;
+    char line[160];
+    snprintf(line, sizeof(line), "%-5s %-7s %-8s %-10s %-10s %-14s %-10s\n",
+             "Rank", "Layers", "Neurons", "Activation", "LR", "Final Loss", "Time (ms)");
+    out += line;
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const SweepResult &r = results[i];
+        snprintf(line, sizeof(line), "%-5d %-7d %-8d %-10s %-10.4f %-14.6f %-10.1f\n",
+                 (int)i + 1, r.candidate.hiddenLayers, r.candidate.neuronsPerLayer,
+                 activationName(r.candidate.activation), r.candidate.learningRate,
+                 r.finalLoss, r.wallTimeMs);
+        out += line;
+    }
+    return out;
+}
@@ -0,0 +1,244 @@
+#include "threadpool.h"
+#include <algorithm>
+#include <iterator>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Pool settings; frozen once the pool exists
+std::mutex configMutex;
+int configThreads = 0;
+bool configPin = false;
+bool poolCreated = false;
+
+// Index of the pool worker running on this thread (-1 = outside thread)
+thread_local int currentWorker = -1;
+
+void pinCurrentThread(int core) {
+#if defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (core % (int)(sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core; // No affinity API (e.g. macOS): run unpinned
+#endif
+}
+
+} // namespace
+
+// --- ThreadPool ---
+
+bool ThreadPool::configure(int threads, bool pinToCores) {
+    std::lock_guard<std::mutex> lock(configMutex);
+    if (poolCreated) return false;
+    configThreads = threads;
+    configPin = pinToCores;
+    return true;
+}
+
+ThreadPool &ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+ThreadPool::ThreadPool() : queued(0), nextQueue(0), stopping(false) {
+    int threads;
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        poolCreated = true;
+        threads = configThreads > 0 ? configThreads : (int)std::thread::hardware_concurrency();
+        pinned = configPin;
+    }
+
+    // The calling thread helps inside wait(), so it counts as one of 'threads'
+    int workerCount = std::max(1, threads) - 1;
+    for (int i = 0; i <= workerCount; i++) queues.emplace_back(new WorkerQueue);
+    for (int i = 0; i < workerCount; i++) workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (auto &t : workers) t.join();
+}
+
+void ThreadPool::submit(Task task, TaskPriority priority) {
+    // Workers push to their own deque; outside threads spread work round-robin
+    int target = currentWorker >= 0 ? currentWorker : (int)(nextQueue++ % queues.size());
+    {
+        std::lock_guard<std::mutex> lock(queues[target]->mutex);
+        queues[target]->tasks[(int)priority].push_back(std::move(task));
+    }
+    queued++;
+
+    // Taking the lock orders this notify after a sleeper's predicate check
+    { std::lock_guard<std::mutex> lock(sleepMutex); }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::popTask(int self, TaskPriority priority, Task &out) {
+    int p = (int)priority;
+
+    // 1. Own deque, newest first
+    if (self >= 0) {
+        WorkerQueue &q = *queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks[p].empty()) {
+            out = std::move(q.tasks[p].back());
+            q.tasks[p].pop_back();
+            queued--;
+            return true;
+        }
+    }
+
+    // 2. Steal the oldest task from someone else
+    int n = (int)queues.size();
+    int start = self >= 0 ? self + 1 : 0;
+    for (int k = 0; k < n; k++) {
+        int victim = (start + k) % n;
+        if (victim == self) continue;
+        WorkerQueue &q = *queues[victim];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (!q.tasks[p].empty()) {
+            out = std::move(q.tasks[p].front());
+            q.tasks[p].pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::popGroupTask(int self, const TaskGroup &group, Task &out) {
+    int p = (int)group.priority;
+
+    // Same order as popTask(): own deque newest first, then the others oldest first
+    int n = (int)queues.size();
+    int start = self >= 0 ? self : 0;
+    for (int k = 0; k < n; k++) {
+        int victim = (start + k) % n;
+        WorkerQueue &q = *queues[victim];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        std::deque<Task> &tasks = q.tasks[p];
+        if (victim == self) {
+            for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
+                if (it->group != &group) continue;
+                out = std::move(*it);
+                tasks.erase(std::next(it).base());
+                queued--;
+                return true;
+            }
+        } else {
+            for (auto it = tasks.begin(); it != tasks.end(); ++it) {
+                if (it->group != &group) continue;
+                out = std::move(*it);
+                tasks.erase(it);
+                queued--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task &task) {
+    task.fn();
+
+    // Decrement and notify under the lock: a waiter that sees 0 may destroy
+    // the group as soon as it can take doneMutex again
+    TaskGroup &group = *task.group;
+    std::lock_guard<std::mutex> lock(group.doneMutex);
+    if (group.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) group.done.notify_all();
+}
+
+bool ThreadPool::runOne(TaskGroup &group) {
+    Task task;
+    if (!popGroupTask(currentWorker, group, task)) return false;
+    execute(task);
+    return true;
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentWorker = index;
+    if (pinned) {
+        // Core 0 is left to the thread that owns the pool (usually the UI thread)
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        pinCurrentThread((index + 1) % cores);
+    }
+
+    for (;;) {
+        Task task;
+        if (popTask(index, TaskPriority::HIGH, task) || popTask(index, TaskPriority::LOW, task)) {
+            execute(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
+
+// --- TaskGroup ---
+
+TaskGroup::TaskGroup(TaskPriority taskPriority, ThreadPool &threadPool)
+    : pool(threadPool), priority(taskPriority), pending(0)
+{
+}
+
+void TaskGroup::run(std::function<void()> fn) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool.submit({ std::move(fn), this }, priority);
+}
+
+void TaskGroup::wait() {
+    // Run whatever of this group is still queued; never another group's task,
+    // so a UI thread waiting on its heatmap cannot get stuck in a training pack
+    while (pending.load(std::memory_order_acquire) > 0 && pool.runOne(*this)) {}
+
+    // The rest is running on other threads: sleep instead of spinning a core.
+    // Always taking the lock also waits out the last execute() still holding it.
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [this] { return pending.load(std::memory_order_acquire) == 0; });
+}
+
+// --- parallelFor ---
+
+void parallelFor(size_t begin, size_t end, size_t grain,
+                 const std::function<void(size_t, size_t)> &body,
+                 TaskPriority priority) {
+    if (end <= begin) return;
+    ThreadPool &pool = ThreadPool::instance();
+
+    // A few chunks per thread lets stealing even out chunks of uneven cost
+    size_t count = end - begin;
+    size_t chunks = (count + std::max<size_t>(grain, 1) - 1) / std::max<size_t>(grain, 1);
+    chunks = std::min(chunks, (size_t)pool.getThreadCount() * 4);
+
+    if (chunks <= 1 || pool.getThreadCount() == 1) {
+        body(begin, end);
+        return;
+    }
+
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    TaskGroup group(priority, pool);
+    for (size_t b = begin + chunkSize; b < end; b += chunkSize) {
+        size_t e = std::min(end, b + chunkSize);
+        group.run([&body, b, e] { body(b, e); });
+    }
+    body(begin, std::min(end, begin + chunkSize));
+    group.wait();
+}
@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = IngestQueueTest
+
+QT -= core gui
+CONFIG += c++17 console
+CONFIG -= qt app_bundle warn_on
+
+# Header-only queue under test
+INCLUDEPATH += ../include
+
+SOURCES += \
+    ingestqueue_test.cpp
+
+unix: LIBS += -lpthread
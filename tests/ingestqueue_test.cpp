@@ -0,0 +1,95 @@
+// Stress test for IngestQueue (include/ingestqueue.h).
+//
+// Several producers push while one consumer pops concurrently. Every value
+// must arrive exactly once and, per producer, in push order. Build with
+// ThreadSanitizer to check the memory ordering as well:
+//   qmake tests/IngestQueueTest.pro CONFIG+=sanitizer CONFIG+=sanitize_thread
+
+#include "ingestqueue.h"
+#include "dataset.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int PRODUCERS = 4;
+const int PER_PRODUCER = 100000;
+
+// DataPoint is what RenderArea pushes: x = sequence number, classID = producer
+bool testPoints() {
+    IngestQueue<DataPoint> queue;
+    std::atomic<int> finished(0);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < PRODUCERS; t++) {
+        producers.emplace_back([&queue, &finished, t] {
+            for (int i = 0; i < PER_PRODUCER; i++) queue.push({ (double)i, 0.0, t });
+            finished++;
+        });
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    bool ok = true;
+    size_t received = 0;
+    DataPoint p;
+    while (received < (size_t)PRODUCERS * PER_PRODUCER) {
+        bool allPushed = finished == PRODUCERS; // Read before pop(): those pushes must be visible
+        if (!queue.pop(p)) {
+            if (allPushed) {
+                ok = false; // Queue reads empty with values still missing
+                break;
+            }
+            continue;
+        }
+        received++;
+        if (p.classID < 0 || p.classID >= PRODUCERS || (int)p.x != next[p.classID]) {
+            ok = false; // Lost, duplicated or reordered
+            break;
+        }
+        next[p.classID]++;
+    }
+    for (auto &t : producers) t.join();
+
+    ok = ok && queue.empty() && !queue.pop(p);
+    printf("%d producers x %d points: %zu received, %s\n", PRODUCERS, PER_PRODUCER, received,
+           ok ? "in order" : "LOST OR REORDERED");
+    return ok;
+}
+
+// Heap-owning values: moved out intact, leftovers freed by the destructor
+bool testOwnedValues() {
+    bool ok = true;
+    {
+        IngestQueue<std::string> queue;
+        std::vector<std::thread> producers;
+        for (int t = 0; t < PRODUCERS; t++) {
+            producers.emplace_back([&queue, t] {
+                for (int i = 0; i < 1000; i++) queue.push(std::string(64, (char)('a' + t)) + std::to_string(i));
+            });
+        }
+
+        std::string value;
+        for (int popped = 0; popped < PRODUCERS * 500;) {
+            if (!queue.pop(value)) continue;
+            popped++;
+            if (value.size() < 65 || value[0] < 'a' || value[0] >= 'a' + PRODUCERS) ok = false;
+        }
+        for (auto &t : producers) t.join();
+        // Half the strings are still queued here
+    }
+    printf("owned values: %s\n", ok ? "intact" : "CORRUPTED");
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    bool ok = testPoints();
+    ok = testOwnedValues() && ok;
+    printf("%s\n", ok ? "IngestQueue test passed" : "IngestQueue test FAILED");
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}